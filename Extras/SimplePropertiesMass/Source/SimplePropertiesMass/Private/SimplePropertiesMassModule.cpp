@@ -0,0 +1,5 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, SimplePropertiesMass)
@@ -0,0 +1,42 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#include "SimplePropertyMass.h"
+#include "MassExecutionContext.h"
+#include "MassSignalSubsystem.h"
+#include "Misc/ScopeLock.h"
+
+void FSimplePropertyMassChanges::Signal(UMassSignalSubsystem& InSignals, FName InSignal)
+{
+	check(IsInGameThread());
+
+	if (!Entities.IsEmpty())
+	{
+		InSignals.SignalEntities(InSignal, Entities);
+		Entities.Reset();
+	}
+}
+
+void FSimplePropertyMassChanges::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+	Entities.Reset();
+}
+
+FMassEntityHandle FSimplePropertyMassChanges::GetEntity(const FMassExecutionContext& InContext, int32 InEntityIndex)
+{
+	return InContext.GetEntity(InEntityIndex);
+}
+
+void FSimplePropertyMassChanges::AppendEntities(TConstArrayView<FMassEntityHandle> InEntities)
+{
+	FScopeLock ScopeLock(&Lock);
+	Entities.Append(InEntities);
+}
+
+FSimplePropertyMassChunkChanges::FSimplePropertyMassChunkChanges(const FMassExecutionContext& InContext,
+	FSimplePropertyMassChanges& InChanges)
+	: Context(InContext)
+	, Changes(InChanges)
+	, Changed(false, InContext.GetNumEntities())
+{
+}
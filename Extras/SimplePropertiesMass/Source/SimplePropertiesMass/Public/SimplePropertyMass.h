@@ -0,0 +1,187 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/BitArray.h"
+#include "HAL/CriticalSection.h"
+#include "MassEntityTypes.h"
+#include "SimplePropertyTypeTraits.h"
+#include "Templates/UnrealTemplate.h"
+#include <type_traits>
+
+class UMassSignalSubsystem;
+struct FMassExecutionContext;
+
+/**
+ * Entities whose properties changed during a processor's execution, gathered from every chunk it ran over. Chunks
+ * executed in parallel add to it once each, when they finish.
+ *
+ *	FSimplePropertyMassChanges Changes;
+ *
+ *	EntityQuery.ParallelForEachEntityChunk(EntityManager, Context, [&Changes](FMassExecutionContext& InContext)
+ *		{
+ *			FSimplePropertyMassChunkChanges ChunkChanges(InContext, Changes);
+ *			const TArrayView<FCrowdFragment> Crowd = InContext.GetMutableFragmentView<FCrowdFragment>();
+ *
+ *			for (int32 EntityIndex = 0; EntityIndex < InContext.GetNumEntities(); ++EntityIndex)
+ *			{
+ *				Crowd[EntityIndex].Mood.Set(NewMood, ChunkChanges, EntityIndex);
+ *			}
+ *		});
+ *
+ *	Changes.Signal(*SignalSubsystem, UE::Mass::Signals::MoodChanged);
+ */
+class SIMPLEPROPERTIESMASS_API FSimplePropertyMassChanges
+{
+public:
+	FSimplePropertyMassChanges() = default;
+	FSimplePropertyMassChanges(const FSimplePropertyMassChanges&) = delete;
+	FSimplePropertyMassChanges& operator=(const FSimplePropertyMassChanges&) = delete;
+
+	/** For handing the changed set to your own processing. Not thread safe against chunks still adding to it. */
+	TConstArrayView<FMassEntityHandle> GetEntities() const
+	{
+		return Entities;
+	}
+
+	bool IsEmpty() const
+	{
+		return Entities.IsEmpty();
+	}
+
+	/** Raises InSignal for all the changed entities in one call, then clears the set. Game thread. */
+	void Signal(UMassSignalSubsystem& InSignals, FName InSignal);
+
+	void Reset();
+
+	/** Adds the entities of the chunk being executed whose bits are set. Called by FSimplePropertyMassChunkChanges. */
+	template<typename InAllocatorType>
+	void Append(const FMassExecutionContext& InContext, const TBitArray<InAllocatorType>& InChanged)
+	{
+		TArray<FMassEntityHandle, TInlineAllocator<64>> ChunkEntities;
+
+		for (TConstSetBitIterator<InAllocatorType> It(InChanged); It; ++It)
+		{
+			ChunkEntities.Add(GetEntity(InContext, It.GetIndex()));
+		}
+
+		AppendEntities(ChunkEntities);
+	}
+
+protected:
+	FCriticalSection Lock;
+	TArray<FMassEntityHandle> Entities;
+
+	static FMassEntityHandle GetEntity(const FMassExecutionContext& InContext, int32 InEntityIndex);
+	void AppendEntities(TConstArrayView<FMassEntityHandle> InEntities);
+};
+
+/**
+ * Changed bits for the chunk being executed, one per entity. Adds the changed entities to the processor's change
+ * set when it goes out of scope, so the shared set is only touched once per chunk.
+ */
+class FSimplePropertyMassChunkChanges
+{
+public:
+	using FBitArray = TBitArray<TInlineAllocator<8>>;
+
+	SIMPLEPROPERTIESMASS_API FSimplePropertyMassChunkChanges(const FMassExecutionContext& InContext, FSimplePropertyMassChanges& InChanges);
+
+	FSimplePropertyMassChunkChanges(const FSimplePropertyMassChunkChanges&) = delete;
+	FSimplePropertyMassChunkChanges& operator=(const FSimplePropertyMassChunkChanges&) = delete;
+
+	~FSimplePropertyMassChunkChanges()
+	{
+		if (bAnyChanged)
+		{
+			Changes.Append(Context, Changed);
+		}
+	}
+
+	void Mark(int32 InEntityIndex)
+	{
+		Changed[InEntityIndex] = true;
+		bAnyChanged = true;
+	}
+
+	bool IsChanged(int32 InEntityIndex) const
+	{
+		return Changed[InEntityIndex];
+	}
+
+protected:
+	const FMassExecutionContext& Context;
+	FSimplePropertyMassChanges& Changes;
+	FBitArray Changed;
+	bool bAnyChanged = false;
+};
+
+/**
+ * TSimpleProperty semantics for fragment data: sets are compared with the value type's comparator and only a
+ * different value marks its entity changed. There's no callback storage, the property is exactly the size of its
+ * value, so it fits Mass's chunk layout like the raw value would. Changes are reported in bulk through
+ * FSimplePropertyMassChanges instead of per entity.
+ *
+ * Not reflected; use it for fragment members that aren't UPROPERTYs.
+ */
+template<typename InValueType>
+struct TSimpleMassProperty
+{
+	using FValueType = InValueType;
+	using FComparatorType = TSimplePropertyTypeTraits<FValueType>::template FComparatorType;
+
+	TSimpleMassProperty() = default;
+
+	TSimpleMassProperty(const FValueType& InValue)
+		: Value(InValue)
+	{
+	}
+
+	const FValueType& Get() const
+	{
+		return Value;
+	}
+
+	operator const FValueType&() const
+	{
+		return Value;
+	}
+
+	const FValueType& operator*() const
+	{
+		return Value;
+	}
+
+	const FValueType* operator->() const
+	{
+		return &Value;
+	}
+
+	/** Stores the value and marks the entity changed if it's different. Returns true if it was. */
+	template<typename InAssignType>
+	bool Set(InAssignType&& InValue, FSimplePropertyMassChunkChanges& InChanges, int32 InEntityIndex)
+	{
+		if (FComparatorType::template IsEqual<FValueType, std::decay_t<InAssignType>>(Value, InValue))
+		{
+			return false;
+		}
+
+		Value = Forward<InAssignType>(InValue);
+		InChanges.Mark(InEntityIndex);
+		return true;
+	}
+
+	/** Stores the value without change detection, for initialising new entities. */
+	template<typename InAssignType>
+	void SetSilently(InAssignType&& InValue)
+	{
+		Value = Forward<InAssignType>(InValue);
+	}
+
+protected:
+	FValueType Value = FValueType();
+};
+
+static_assert(sizeof(TSimpleMassProperty<float>) == sizeof(float));
+static_assert(sizeof(TSimpleMassProperty<int32>) == sizeof(int32));
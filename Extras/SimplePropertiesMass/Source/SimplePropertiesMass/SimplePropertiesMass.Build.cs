@@ -0,0 +1,29 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class SimplePropertiesMass : ModuleRules
+{
+    public SimplePropertiesMass(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core",
+                "MassEntity",
+                "MassSignals",
+                "SimpleProperties"
+            }
+        );
+
+        PrivateDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "CoreUObject",
+                "Engine"
+            }
+        );
+    }
+}
@@ -0,0 +1,336 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+// Reads the property mirror (SimplePropertyMirror.h) of a running game from another process. Standalone, it doesn't
+// link against the engine:
+//
+//	c++ -std=c++17 -O2 SimplePropertiesMirrorReader.cpp -o SimplePropertiesMirrorReader     (Linux: add -lrt on old glibc)
+//	cl /std:c++17 /O2 /EHsc SimplePropertiesMirrorReader.cpp                                (Windows)
+//
+//	SimplePropertiesMirrorReader <ProcessId> [--watch <Milliseconds>] [--changed]
+//
+// The layout below must match UE::SimpleProperties::Mirror.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Mirror
+{
+	constexpr uint32_t Magic = 0x524D5053; // "SPMR"
+	constexpr uint32_t Version = 2;
+	constexpr int NameLength = 64;
+	constexpr int TypeLength = 64;
+	constexpr int ValueBytes = 64;
+
+	struct FSlot
+	{
+		std::atomic<uint32_t> Sequence;
+		uint32_t ValueSize;
+		uint64_t Generation;
+		char Name[NameLength];
+		char Type[TypeLength];
+		uint8_t Value[ValueBytes];
+	};
+
+	struct FHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t MaxSlots;
+		uint32_t SlotSize;
+		std::atomic<uint32_t> NumSlots;
+		uint32_t SlotsOffset;
+	};
+
+	// A plain copy of a slot.
+	struct FSlotCopy
+	{
+		uint32_t ValueSize;
+		uint64_t Generation;
+		char Name[NameLength];
+		char Type[TypeLength];
+		uint8_t Value[ValueBytes];
+	};
+
+	static_assert(sizeof(FSlot) == 208 && alignof(FSlot) == 8, "FSlot no longer matches the engine's layout.");
+	static_assert(sizeof(FHeader) == 24, "FHeader no longer matches the engine's layout.");
+}
+
+class FMappedMirror
+{
+public:
+	~FMappedMirror()
+	{
+#if defined(_WIN32)
+		if (Memory)
+		{
+			UnmapViewOfFile(Memory);
+		}
+
+		if (Mapping)
+		{
+			CloseHandle(Mapping);
+		}
+#else
+		if (Memory)
+		{
+			munmap(Memory, Size);
+		}
+#endif
+	}
+
+	bool Open(unsigned long InProcessId)
+	{
+		const std::string Name = "SimplePropertiesMirror_" + std::to_string(InProcessId);
+
+#if defined(_WIN32)
+		// FWindowsPlatformMemory::MapNamedSharedMemoryRegion creates the mapping in the global namespace.
+		Mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, ("Global\\" + Name).c_str());
+
+		if (!Mapping)
+		{
+			return false;
+		}
+
+		Memory = MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0);
+
+		MEMORY_BASIC_INFORMATION Info;
+		Size = Memory && VirtualQuery(Memory, &Info, sizeof(Info)) ? Info.RegionSize : 0;
+#else
+		// The engine prefixes shared memory names with a slash on Unix.
+		const int Fd = shm_open(("/" + Name).c_str(), O_RDONLY, 0);
+
+		if (Fd < 0)
+		{
+			return false;
+		}
+
+		struct stat Stat;
+
+		if (fstat(Fd, &Stat) == 0)
+		{
+			Size = static_cast<size_t>(Stat.st_size);
+			Memory = mmap(nullptr, Size, PROT_READ, MAP_SHARED, Fd, 0);
+
+			if (Memory == MAP_FAILED)
+			{
+				Memory = nullptr;
+			}
+		}
+
+		close(Fd);
+#endif
+
+		return Memory && Size >= sizeof(Mirror::FHeader);
+	}
+
+	const Mirror::FHeader* GetHeader() const
+	{
+		const Mirror::FHeader* Header = static_cast<const Mirror::FHeader*>(Memory);
+
+		// Magic is written last by the engine.
+		if (Header->Magic != Mirror::Magic)
+		{
+			return nullptr;
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		if (Header->Version != Mirror::Version || Header->SlotSize != sizeof(Mirror::FSlot)
+			|| Header->SlotsOffset + static_cast<size_t>(Header->MaxSlots) * sizeof(Mirror::FSlot) > Size)
+		{
+			return nullptr;
+		}
+
+		return Header;
+	}
+
+	const Mirror::FSlot& GetSlot(const Mirror::FHeader& InHeader, uint32_t InIndex) const
+	{
+		const uint8_t* Slots = static_cast<const uint8_t*>(Memory) + InHeader.SlotsOffset;
+		return reinterpret_cast<const Mirror::FSlot*>(Slots)[InIndex];
+	}
+
+private:
+	void* Memory = nullptr;
+	size_t Size = 0;
+
+#if defined(_WIN32)
+	HANDLE Mapping = nullptr;
+#endif
+};
+
+// The reader side of the slot's seqlock. False if the writer kept changing it.
+bool ReadSlot(const Mirror::FSlot& InSlot, Mirror::FSlotCopy& OutCopy)
+{
+	for (int Attempt = 0; Attempt < 64; ++Attempt)
+	{
+		const uint32_t Before = InSlot.Sequence.load(std::memory_order_acquire);
+
+		if (Before & 1)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		OutCopy.ValueSize = InSlot.ValueSize;
+		OutCopy.Generation = InSlot.Generation;
+		std::memcpy(OutCopy.Name, InSlot.Name, sizeof(OutCopy.Name));
+		std::memcpy(OutCopy.Type, InSlot.Type, sizeof(OutCopy.Type));
+		std::memcpy(OutCopy.Value, InSlot.Value, sizeof(OutCopy.Value));
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		if (InSlot.Sequence.load(std::memory_order_relaxed) == Before)
+		{
+			OutCopy.Name[Mirror::NameLength - 1] = '\0';
+			OutCopy.Type[Mirror::TypeLength - 1] = '\0';
+			OutCopy.ValueSize = OutCopy.ValueSize > Mirror::ValueBytes ? Mirror::ValueBytes : OutCopy.ValueSize;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+template<typename InType>
+bool FormatAs(const Mirror::FSlotCopy& InSlot, const char* InFormat, std::string& OutText)
+{
+	if (InSlot.ValueSize != sizeof(InType))
+	{
+		return false;
+	}
+
+	InType Value;
+	std::memcpy(&Value, InSlot.Value, sizeof(Value));
+
+	char Buffer[64];
+	std::snprintf(Buffer, sizeof(Buffer), InFormat, Value);
+	OutText = Buffer;
+	return true;
+}
+
+// Type names are as the compiler spells them, so only the common scalars are decoded. Everything else is hex.
+std::string FormatValue(const Mirror::FSlotCopy& InSlot)
+{
+	const std::string Type = InSlot.Type;
+	std::string Text;
+
+	if ((Type == "float" && FormatAs<float>(InSlot, "%g", Text))
+		|| (Type == "double" && FormatAs<double>(InSlot, "%g", Text))
+		|| (Type == "int" && FormatAs<int32_t>(InSlot, "%d", Text))
+		|| (Type == "unsigned int" && FormatAs<uint32_t>(InSlot, "%u", Text))
+		|| ((Type == "long long" || Type == "__int64") && FormatAs<long long>(InSlot, "%lld", Text)))
+	{
+		return Text;
+	}
+
+	if (Type == "bool" && InSlot.ValueSize == 1)
+	{
+		return InSlot.Value[0] ? "true" : "false";
+	}
+
+	static const char Digits[] = "0123456789ABCDEF";
+
+	for (uint32_t Index = 0; Index < InSlot.ValueSize; ++Index)
+	{
+		Text += Digits[InSlot.Value[Index] >> 4];
+		Text += Digits[InSlot.Value[Index] & 0xF];
+	}
+
+	return Text;
+}
+
+int main(int InArgc, char** InArgv)
+{
+	if (InArgc < 2)
+	{
+		std::fprintf(stderr, "Usage: %s <ProcessId> [--watch <Milliseconds>] [--changed]\n", InArgv[0]);
+		return 2;
+	}
+
+	const unsigned long ProcessId = std::strtoul(InArgv[1], nullptr, 10);
+	int WatchMilliseconds = 0;
+	bool bChangedOnly = false;
+
+	for (int Arg = 2; Arg < InArgc; ++Arg)
+	{
+		if (std::strcmp(InArgv[Arg], "--watch") == 0 && Arg + 1 < InArgc)
+		{
+			WatchMilliseconds = std::atoi(InArgv[++Arg]);
+		}
+		else if (std::strcmp(InArgv[Arg], "--changed") == 0)
+		{
+			bChangedOnly = true;
+		}
+	}
+
+	FMappedMirror Mapped;
+
+	if (!Mapped.Open(ProcessId))
+	{
+		std::fprintf(stderr, "No property mirror for process %lu.\n", ProcessId);
+		return 1;
+	}
+
+	const Mirror::FHeader* Header = Mapped.GetHeader();
+
+	if (!Header)
+	{
+		std::fprintf(stderr, "The property mirror of process %lu isn't ready or has a different version.\n", ProcessId);
+		return 1;
+	}
+
+	std::vector<uint64_t> LastGenerations(Header->MaxSlots, 0);
+
+	do
+	{
+		const uint32_t NumSlots = Header->NumSlots.load(std::memory_order_acquire);
+
+		for (uint32_t Index = 0; Index < NumSlots && Index < Header->MaxSlots; ++Index)
+		{
+			Mirror::FSlotCopy Copy;
+
+			// Free slots have an empty name.
+			if (!ReadSlot(Mapped.GetSlot(*Header, Index), Copy) || Copy.Name[0] == '\0')
+			{
+				continue;
+			}
+
+			if (bChangedOnly && LastGenerations[Index] == Copy.Generation)
+			{
+				continue;
+			}
+
+			LastGenerations[Index] = Copy.Generation;
+			std::printf("%s (%s) gen %llu: %s\n", Copy.Name, Copy.Type, static_cast<unsigned long long>(Copy.Generation),
+				FormatValue(Copy).c_str());
+		}
+
+		std::fflush(stdout);
+
+		if (WatchMilliseconds > 0)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(WatchMilliseconds));
+		}
+	}
+	while (WatchMilliseconds > 0);
+
+	return 0;
+}
@@ -0,0 +1,7 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "Logging/LogMacros.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogSimpleProperties, Log, All);
@@ -3,12 +3,25 @@
 #include "Modules/ModuleInterface.h"
 #include "GameFramework/Actor.h"
 #include "Modules/ModuleManager.h"
+#include "SimplePropertiesLog.h"
 #include "SimpleProperty.h"
+#include "SimplePropertyBuffered.h"
+#include "SimplePropertyContainers.h"
+#include "SimplePropertyInnerPropertyCache.h"
+#include "SimplePropertyJournal.h"
+#include "SimplePropertyMirror.h"
+#include "SimplePropertyObjectTraits.h"
+#include "SimplePropertyPropagation.h"
+#include "SimplePropertyPushModel.h"
+#include "SimplePropertySoft.h"
+#include "SimplePropertyTween.h"
 
 #if WITH_EDITOR
 #include "ScopedTransaction.h"
 #endif
 
+DEFINE_LOG_CATEGORY(LogSimpleProperties);
+
 namespace UE::SimpleProperties::Private
 {
 	void SimpleGlobalFunction()
@@ -25,11 +38,38 @@ private:
 public:
 	virtual void StartupModule() override
 	{
+		FSimplePropertyPropagation::Initialize();
+		FSimplePropertyInnerPropertyCache::Initialize();
+		FSimplePropertyTweens::Initialize();
+		FSimplePropertyBuffers::Initialize();
+
+#if SIMPLE_PROPERTIES_WITH_PUSH_MODEL
+		FSimplePropertyPushModel::Initialize();
+#endif
+
 		PerformTests();
 	}
 
 	virtual void ShutdownModule() override
 	{
+		FSimplePropertyInnerPropertyCache::Shutdown();
+		FSimplePropertySoftLoader::Shutdown();
+		FSimplePropertyTweens::Shutdown();
+		FSimplePropertyBuffers::Shutdown();
+
+#if SIMPLE_PROPERTIES_WITH_PUSH_MODEL
+		FSimplePropertyPushModel::Shutdown();
+#endif
+
+#if SIMPLE_PROPERTIES_WITH_JOURNAL
+		FSimplePropertyJournal::Shutdown();
+#endif
+
+#if SIMPLE_PROPERTIES_WITH_MIRROR
+		FSimplePropertyMirror::Shutdown();
+#endif
+
+		FSimplePropertyPropagation::Shutdown();
 	}
 
 protected:
@@ -130,6 +170,16 @@ protected:
 
 		const bool bValid = (*SharedVector).IsValid();
 
+		TSimpleArrayProperty<int32> ArrayProp = {{1, 2, 3},
+			TSimpleArrayProperty<int32>::FOnCallback::CreateLambda([](const FSimplePropertyArrayChange& InChange) {})};
+		ArrayProp.Add(4);
+		ArrayProp.SetAt(0, 1); // Same value, no event
+		ArrayProp.RemoveAt(1);
+
+		TSimpleMapProperty<FName, int32> MapProp;
+		MapProp.Add(TEXT("Foo"), 1);
+		MapProp.Add(TEXT("Foo"), 2); // Set event for Foo
+
 #if WITH_EDITOR
 		const bool bStartedTransaction = ColorProperty.StartManagedTransaction(INVTEXT("Test Managed Transaction"));
 		const bool bHasManagedTransaction = VectorProperty6.HasManagedTransaction();
@@ -0,0 +1,13 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#include "SimpleProperty.h"
+
+// Explicit instantiation instantiates NextChange, which returns its awaiter by value.
+#include "SimplePropertyAwait.h"
+
+template struct SIMPLEPROPERTIES_API TSimpleConstProperty<bool>;
+template struct SIMPLEPROPERTIES_API TSimpleConstProperty<uint8>;
+template struct SIMPLEPROPERTIES_API TSimpleConstProperty<int32>;
+template struct SIMPLEPROPERTIES_API TSimpleConstProperty<int64>;
+template struct SIMPLEPROPERTIES_API TSimpleConstProperty<float>;
+template struct SIMPLEPROPERTIES_API TSimpleConstProperty<double>;
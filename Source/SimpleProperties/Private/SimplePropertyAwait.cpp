@@ -0,0 +1,170 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#include "SimplePropertyAwait.h"
+
+#if SIMPLE_PROPERTIES_WITH_COROUTINES
+
+#include "Misc/AssertionMacros.h"
+
+namespace UE::SimpleProperties::Private
+{
+	// Once nothing waits on the property or is being resumed for it, it no longer needs the hook.
+	void DetachAwaitIfUnused(int32 InHookSlot)
+	{
+		const FSimplePropertyHooks::FSlot& Slot = FSimplePropertyHooks::GetSlot(InHookSlot);
+
+		if (!Slot.AwaitList && !Slot.AwaitResume)
+		{
+			FSimplePropertyHooks::Detach(InHookSlot, ESimplePropertyHook::Await);
+		}
+	}
+}
+
+void FSimplePropertyAwait::Resume(int32 InHookSlot)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	checkSlow(IsInGameThread());
+
+	FSimplePropertyHooks::FSlot& Slot = FSimplePropertyHooks::GetSlot(InHookSlot);
+
+	if (!Slot.AwaitList)
+	{
+		return;
+	}
+
+	// Moved off the slot so that waits started by the resumed coroutines go on a fresh list for the next change.
+	// A resumed coroutine may destroy other waiters, which unlink themselves from this context.
+	FSimplePropertyAwaitResume Context;
+	Context.Head = Slot.AwaitList;
+	Context.Outer = Slot.AwaitResume;
+
+	Slot.AwaitList = nullptr;
+	Slot.AwaitResume = &Context;
+
+	ResumeAll(Context);
+
+	// The slot was released with the property, and may belong to another one by now.
+	if (Context.bPropertyDestroyed)
+	{
+		return;
+	}
+
+	FSimplePropertyHooks::GetSlot(InHookSlot).AwaitResume = Context.Outer;
+	DetachAwaitIfUnused(InHookSlot);
+}
+
+void FSimplePropertyAwait::Cancel(int32 InHookSlot)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	checkSlow(IsInGameThread());
+
+	FSimplePropertyHooks::FSlot& Slot = FSimplePropertyHooks::GetSlot(InHookSlot);
+
+	// Changes being handled further up the stack cancel the rest of their waiters instead of resuming them.
+	for (FSimplePropertyAwaitResume* Outer = Slot.AwaitResume; Outer; Outer = Outer->Outer)
+	{
+		Outer->bPropertyDestroyed = true;
+	}
+
+	FSimplePropertyAwaitResume Context;
+	Context.Head = Slot.AwaitList;
+	Context.bPropertyDestroyed = true;
+
+	Slot.AwaitList = nullptr;
+	Slot.AwaitResume = nullptr;
+
+	ResumeAll(Context);
+}
+
+void FSimplePropertyAwait::Link(FNode& InNode)
+{
+	checkSlow(IsInGameThread());
+	check(!InNode.bLinked);
+
+	FSimplePropertyAwaitNode*& Head = FSimplePropertyHooks::GetSlot(InNode.HookSlot).AwaitList;
+
+	InNode.Prev = nullptr;
+	InNode.Next = Head;
+	InNode.Resuming = nullptr;
+	InNode.bLinked = true;
+
+	if (Head)
+	{
+		Head->Prev = &InNode;
+	}
+
+	Head = &InNode;
+}
+
+void FSimplePropertyAwait::Unlink(FNode& InNode)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	if (!InNode.bLinked)
+	{
+		return;
+	}
+
+	FSimplePropertyAwaitResume* Resuming = InNode.Resuming;
+	bool bWaitingListEmptied = false;
+
+	if (InNode.Next)
+	{
+		InNode.Next->Prev = InNode.Prev;
+	}
+
+	if (InNode.Prev)
+	{
+		InNode.Prev->Next = InNode.Next;
+	}
+	else if (Resuming)
+	{
+		Resuming->Head = InNode.Next;
+	}
+	else
+	{
+		// Only nodes on the waiting list use the slot, which exists for as long as the property does.
+		FSimplePropertyHooks::GetSlot(InNode.HookSlot).AwaitList = InNode.Next;
+		bWaitingListEmptied = !InNode.Next;
+	}
+
+	InNode.Prev = nullptr;
+	InNode.Next = nullptr;
+	InNode.Resuming = nullptr;
+	InNode.bLinked = false;
+
+	if (bWaitingListEmptied)
+	{
+		DetachAwaitIfUnused(InNode.HookSlot);
+	}
+}
+
+void FSimplePropertyAwait::ResumeAll(FSimplePropertyAwaitResume& InContext)
+{
+	for (FNode* Node = InContext.Head; Node; Node = Node->Next)
+	{
+		Node->Resuming = &InContext;
+	}
+
+	while (FNode* Node = InContext.Head)
+	{
+		Unlink(*Node);
+
+		if (InContext.bPropertyDestroyed)
+		{
+			Node->bCancelled = true;
+		}
+		else if (Node->IsReady && !Node->IsReady(Node))
+		{
+			// Back on the waiting list, for the next change.
+			Link(*Node);
+			continue;
+		}
+
+		Node->Handle.resume();
+	}
+}
+
+#endif
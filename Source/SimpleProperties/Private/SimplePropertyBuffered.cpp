@@ -0,0 +1,138 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#include "SimplePropertyBuffered.h"
+#include "Containers/Array.h"
+#include "Misc/AssertionMacros.h"
+#include "Misc/CoreDelegates.h"
+
+namespace UE::SimpleProperties::Private
+{
+	struct FBufferEntry
+	{
+		// Null while the entry is free, or unregistered but still on the dirty list.
+		void* Property;
+		FSimplePropertyBuffers::FPublishFunction Publish;
+		bool bDirty;
+	};
+
+	// Indexed by the properties' hook slots. Freed entries are reused, but not while they're on the dirty list.
+	TArray<FBufferEntry> BufferEntries;
+	TArray<int32> FreeBufferEntries;
+
+	// Entries changed since the last publish.
+	TArray<int32> DirtyBufferEntries;
+
+	FDelegateHandle BufferEndFrameHandle;
+}
+
+void FSimplePropertyBuffers::MarkDirty(int32 InBufferIndex)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	checkSlow(IsInGameThread());
+
+	FBufferEntry& Entry = BufferEntries[InBufferIndex];
+
+	if (!Entry.bDirty)
+	{
+		Entry.bDirty = true;
+		DirtyBufferEntries.Add(InBufferIndex);
+	}
+}
+
+void FSimplePropertyBuffers::Publish()
+{
+	using namespace UE::SimpleProperties::Private;
+
+	check(IsInGameThread());
+
+	int32 NumRetried = 0;
+
+	for (const int32 BufferIndex : DirtyBufferEntries)
+	{
+		FBufferEntry& Entry = BufferEntries[BufferIndex];
+
+		if (!Entry.Property)
+		{
+			Entry.bDirty = false;
+			FreeBufferEntries.Add(BufferIndex);
+		}
+		else if (Entry.Publish(Entry.Property))
+		{
+			Entry.bDirty = false;
+		}
+		else
+		{
+			// Compacted in place, the retried entries are a prefix of the ones already visited.
+			DirtyBufferEntries[NumRetried++] = BufferIndex;
+		}
+	}
+
+	DirtyBufferEntries.SetNum(NumRetried, EAllowShrinking::No);
+}
+
+int32 FSimplePropertyBuffers::RegisterInternal(void* InProperty, FPublishFunction InPublish)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	checkSlow(IsInGameThread());
+
+	const FBufferEntry Entry{InProperty, InPublish, false};
+
+	if (!FreeBufferEntries.IsEmpty())
+	{
+		const int32 BufferIndex = FreeBufferEntries.Pop(EAllowShrinking::No);
+		BufferEntries[BufferIndex] = Entry;
+		return BufferIndex;
+	}
+
+	return BufferEntries.Add(Entry);
+}
+
+void FSimplePropertyBuffers::UnregisterInternal(int32 InBufferIndex)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	checkSlow(IsInGameThread());
+
+	if (!BufferEntries.IsValidIndex(InBufferIndex))
+	{
+		return;
+	}
+
+	FBufferEntry& Entry = BufferEntries[InBufferIndex];
+	Entry.Property = nullptr;
+	Entry.Publish = nullptr;
+
+	// A dirty entry is freed by the next publish, so it's never on the dirty list twice.
+	if (!Entry.bDirty)
+	{
+		FreeBufferEntries.Add(InBufferIndex);
+	}
+}
+
+void FSimplePropertyBuffers::Initialize()
+{
+	UE::SimpleProperties::Private::BufferEndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&FSimplePropertyBuffers::Publish);
+}
+
+void FSimplePropertyBuffers::Shutdown()
+{
+	using namespace UE::SimpleProperties::Private;
+
+	FCoreDelegates::OnEndFrame.Remove(BufferEndFrameHandle);
+
+	// Kept sized, properties still registered may unregister after shutdown.
+	for (const int32 BufferIndex : DirtyBufferEntries)
+	{
+		FBufferEntry& Entry = BufferEntries[BufferIndex];
+		Entry.bDirty = false;
+
+		if (!Entry.Property)
+		{
+			FreeBufferEntries.Add(BufferIndex);
+		}
+	}
+
+	DirtyBufferEntries.Empty();
+}
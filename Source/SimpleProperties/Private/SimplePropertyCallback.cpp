@@ -0,0 +1,27 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#include "SimplePropertyCallback.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "HAL/PlatformStackWalk.h"
+
+namespace UE::SimpleProperties::Private
+{
+	void DescribeFunction(const void* InFunction, FString& OutDescription)
+	{
+		FProgramCounterSymbolInfo SymbolInfo;
+		FPlatformStackWalk::ProgramCounterToSymbolInfo(reinterpret_cast<uint64>(InFunction), SymbolInfo);
+
+		if (SymbolInfo.FunctionName[0] != '\0')
+		{
+			OutDescription = ANSI_TO_TCHAR(SymbolInfo.FunctionName);
+		}
+		else
+		{
+			OutDescription = FString::Printf(TEXT("Function at 0x%p"), InFunction);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,237 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#include "SimplePropertyHistory.h"
+#include "HAL/UnrealMemory.h"
+#include "Math/UnrealMathUtility.h"
+
+namespace UE::SimpleProperties::Private
+{
+	constexpr int64 InvalidFrame = -1;
+
+	// Fixed-size copies for the common value sizes so the loops don't call memcpy per value.
+	template<int32 InSize>
+	struct TValueBytes
+	{
+		uint8 Bytes[InSize];
+	};
+
+	template<typename InType>
+	void Gather(const TArray<void*>& InValues, uint8* OutFrame)
+	{
+		InType* Dest = reinterpret_cast<InType*>(OutFrame);
+
+		for (int32 Index = 0; Index < InValues.Num(); ++Index)
+		{
+			FMemory::Memcpy(&Dest[Index], InValues[Index], sizeof(InType));
+		}
+	}
+
+	template<typename InType>
+	void Scatter(const uint8* InFrame, const TArray<void*>& InValues)
+	{
+		const InType* Source = reinterpret_cast<const InType*>(InFrame);
+
+		for (int32 Index = 0; Index < InValues.Num(); ++Index)
+		{
+			FMemory::Memcpy(InValues[Index], &Source[Index], sizeof(InType));
+		}
+	}
+
+	void Gather(int32 InValueSize, const TArray<void*>& InValues, uint8* OutFrame)
+	{
+		switch (InValueSize)
+		{
+			case 1: Gather<uint8>(InValues, OutFrame); break;
+			case 2: Gather<uint16>(InValues, OutFrame); break;
+			case 4: Gather<uint32>(InValues, OutFrame); break;
+			case 8: Gather<uint64>(InValues, OutFrame); break;
+			case 12: Gather<TValueBytes<12>>(InValues, OutFrame); break;
+			case 16: Gather<TValueBytes<16>>(InValues, OutFrame); break;
+			case 24: Gather<TValueBytes<24>>(InValues, OutFrame); break;
+			case 32: Gather<TValueBytes<32>>(InValues, OutFrame); break;
+
+			default:
+				for (int32 Index = 0; Index < InValues.Num(); ++Index)
+				{
+					FMemory::Memcpy(OutFrame + Index * InValueSize, InValues[Index], InValueSize);
+				}
+				break;
+		}
+	}
+
+	void Scatter(int32 InValueSize, const uint8* InFrame, const TArray<void*>& InValues)
+	{
+		switch (InValueSize)
+		{
+			case 1: Scatter<uint8>(InFrame, InValues); break;
+			case 2: Scatter<uint16>(InFrame, InValues); break;
+			case 4: Scatter<uint32>(InFrame, InValues); break;
+			case 8: Scatter<uint64>(InFrame, InValues); break;
+			case 12: Scatter<TValueBytes<12>>(InFrame, InValues); break;
+			case 16: Scatter<TValueBytes<16>>(InFrame, InValues); break;
+			case 24: Scatter<TValueBytes<24>>(InFrame, InValues); break;
+			case 32: Scatter<TValueBytes<32>>(InFrame, InValues); break;
+
+			default:
+				for (int32 Index = 0; Index < InValues.Num(); ++Index)
+				{
+					FMemory::Memcpy(InValues[Index], InFrame + Index * InValueSize, InValueSize);
+				}
+				break;
+		}
+	}
+}
+
+FSimplePropertyHistory::FSimplePropertyHistory(int32 InNumFrames)
+	: NumFrames(FMath::Max(InNumFrames, 1))
+{
+	ResetFrames();
+}
+
+FSimplePropertyHistoryHandle FSimplePropertyHistory::TrackInternal(void* InValue, int32 InValueSize, void* InProperty,
+	void (*InNotifyChanged)(void* InProperty))
+{
+	int32 BucketIndex = Buckets.IndexOfByPredicate([InValueSize](const FBucket& InBucket)
+		{
+			return InBucket.ValueSize == InValueSize;
+		});
+
+	if (BucketIndex == INDEX_NONE)
+	{
+		BucketIndex = Buckets.AddDefaulted();
+		Buckets[BucketIndex].ValueSize = InValueSize;
+	}
+
+	const int32 EntryIndex = FreeEntries.IsEmpty() ? Entries.AddDefaulted() : FreeEntries.Pop(EAllowShrinking::No);
+
+	FBucket& Bucket = Buckets[BucketIndex];
+	FEntry& Entry = Entries[EntryIndex];
+	Entry.Bucket = BucketIndex;
+	Entry.Slot = Bucket.Values.Add(InValue);
+	Entry.Property = InProperty;
+	Entry.NotifyChanged = InNotifyChanged;
+	Bucket.Handles.Add(EntryIndex);
+
+	ResetFrames();
+
+	return {EntryIndex};
+}
+
+void FSimplePropertyHistory::Untrack(FSimplePropertyHistoryHandle InHandle)
+{
+	if (!Entries.IsValidIndex(InHandle.Index) || Entries[InHandle.Index].Bucket == INDEX_NONE)
+	{
+		return;
+	}
+
+	FEntry& Entry = Entries[InHandle.Index];
+	FBucket& Bucket = Buckets[Entry.Bucket];
+
+	Bucket.Values.RemoveAtSwap(Entry.Slot, 1, EAllowShrinking::No);
+	Bucket.Handles.RemoveAtSwap(Entry.Slot, 1, EAllowShrinking::No);
+
+	if (Bucket.Handles.IsValidIndex(Entry.Slot))
+	{
+		Entries[Bucket.Handles[Entry.Slot]].Slot = Entry.Slot;
+	}
+
+	Entry = FEntry();
+	FreeEntries.Add(InHandle.Index);
+
+	ResetFrames();
+}
+
+int32 FSimplePropertyHistory::GetFrameSlot(int64 InFrame) const
+{
+	return static_cast<int32>(InFrame % NumFrames);
+}
+
+bool FSimplePropertyHistory::HasFrame(int64 InFrame) const
+{
+	return InFrame >= 0 && FrameNumbers[GetFrameSlot(InFrame)] == InFrame;
+}
+
+void FSimplePropertyHistory::ResetFrames()
+{
+	using namespace UE::SimpleProperties::Private;
+
+	FrameNumbers.Init(InvalidFrame, NumFrames);
+
+	for (FBucket& Bucket : Buckets)
+	{
+		Bucket.Frames.SetNumUninitialized(NumFrames * Bucket.Values.Num() * Bucket.ValueSize);
+	}
+}
+
+void FSimplePropertyHistory::RecordFrame(int64 InFrame)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	if (!ensure(InFrame >= 0))
+	{
+		return;
+	}
+
+	const int32 FrameSlot = GetFrameSlot(InFrame);
+
+	for (FBucket& Bucket : Buckets)
+	{
+		const int32 FrameStride = Bucket.Values.Num() * Bucket.ValueSize;
+		Gather(Bucket.ValueSize, Bucket.Values, Bucket.Frames.GetData() + FrameSlot * FrameStride);
+	}
+
+	FrameNumbers[FrameSlot] = InFrame;
+}
+
+bool FSimplePropertyHistory::Rewind(int64 InFrame)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	if (!HasFrame(InFrame))
+	{
+		return false;
+	}
+
+	const int32 FrameSlot = GetFrameSlot(InFrame);
+
+	for (const FBucket& Bucket : Buckets)
+	{
+		const int32 FrameStride = Bucket.Values.Num() * Bucket.ValueSize;
+		Scatter(Bucket.ValueSize, Bucket.Frames.GetData() + FrameSlot * FrameStride, Bucket.Values);
+	}
+
+	return true;
+}
+
+void FSimplePropertyHistory::FindMispredictions(int64 InFrame, TArray<FSimplePropertyHistoryHandle>& OutMispredicted) const
+{
+	if (!HasFrame(InFrame))
+	{
+		return;
+	}
+
+	const int32 FrameSlot = GetFrameSlot(InFrame);
+
+	for (const FBucket& Bucket : Buckets)
+	{
+		const int32 FrameStride = Bucket.Values.Num() * Bucket.ValueSize;
+		const uint8* Frame = Bucket.Frames.GetData() + FrameSlot * FrameStride;
+
+		for (int32 Slot = 0; Slot < Bucket.Values.Num(); ++Slot)
+		{
+			if (FMemory::Memcmp(Bucket.Values[Slot], Frame + Slot * Bucket.ValueSize, Bucket.ValueSize) != 0)
+			{
+				OutMispredicted.Add({Bucket.Handles[Slot]});
+			}
+		}
+	}
+}
+
+void FSimplePropertyHistory::NotifyChanged(FSimplePropertyHistoryHandle InHandle) const
+{
+	if (Entries.IsValidIndex(InHandle.Index) && Entries[InHandle.Index].NotifyChanged)
+	{
+		const FEntry& Entry = Entries[InHandle.Index];
+		Entry.NotifyChanged(Entry.Property);
+	}
+}
@@ -0,0 +1,183 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#include "SimplePropertyHooks.h"
+#include "Containers/Array.h"
+#include "HAL/CriticalSection.h"
+#include "Misc/AssertionMacros.h"
+#include "Misc/ScopeLock.h"
+#include "SimplePropertyAwait.h"
+#include "SimplePropertyBuffered.h"
+#include "SimplePropertyJournal.h"
+#include "SimplePropertyMirror.h"
+#include "SimplePropertyPushModel.h"
+#include <atomic>
+
+namespace UE::SimpleProperties::Private
+{
+	// Slots are allocated a page at a time and pages are never freed, so a slot never moves.
+	constexpr int32 HookSlotsPerPage = 1024;
+	constexpr int32 MaxHookPages = 1024;
+
+	std::atomic<FSimplePropertyHooks::FSlot*> HookPages[MaxHookPages];
+
+	// Attaching and detaching only.
+	FCriticalSection HookLock;
+	int32 NumHookSlots = 0;
+	TArray<int32> FreeHookSlots;
+
+	void FreeHookSlot(int32 InSlotIndex)
+	{
+		FSimplePropertyHooks::GetSlot(InSlotIndex) = FSimplePropertyHooks::FSlot();
+		FreeHookSlots.Add(InSlotIndex);
+	}
+}
+
+FSimplePropertyHooks::FSlot& FSimplePropertyHooks::GetSlot(int32 InSlotIndex)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	checkSlow(InSlotIndex >= 0 && InSlotIndex < MaxHookPages * HookSlotsPerPage);
+
+	FSlot* Page = HookPages[InSlotIndex / HookSlotsPerPage].load(std::memory_order_acquire);
+	return Page[InSlotIndex % HookSlotsPerPage];
+}
+
+int32 FSimplePropertyHooks::Acquire(const void* InProperty, const void* InValue, int32 InValueSize,
+	void (*InClearProperty)(void*))
+{
+	using namespace UE::SimpleProperties::Private;
+
+	FScopeLock Lock(&HookLock);
+
+	int32 SlotIndex = INDEX_NONE;
+
+	if (!FreeHookSlots.IsEmpty())
+	{
+		SlotIndex = FreeHookSlots.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		SlotIndex = NumHookSlots++;
+		checkf(SlotIndex < MaxHookPages * HookSlotsPerPage, TEXT("Too many properties have hooks attached."));
+
+		std::atomic<FSlot*>& Page = HookPages[SlotIndex / HookSlotsPerPage];
+
+		if (!Page.load(std::memory_order_relaxed))
+		{
+			Page.store(new FSlot[HookSlotsPerPage], std::memory_order_release);
+		}
+	}
+
+	FSlot& Slot = GetSlot(SlotIndex);
+	Slot.Property = InProperty;
+	Slot.Value = InValue;
+	Slot.ValueSize = InValueSize;
+	Slot.Hooks = ESimplePropertyHook::None;
+	Slot.ClearProperty = InClearProperty;
+
+	return SlotIndex;
+}
+
+void FSimplePropertyHooks::Detach(int32 InSlotIndex, ESimplePropertyHook InHook)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	FScopeLock Lock(&HookLock);
+
+	FSlot& Slot = GetSlot(InSlotIndex);
+	Slot.Hooks &= ~InHook;
+
+	if (Slot.Hooks == ESimplePropertyHook::None)
+	{
+		Slot.ClearProperty(const_cast<void*>(Slot.Property));
+		FreeHookSlot(InSlotIndex);
+	}
+}
+
+void FSimplePropertyHooks::OnChanged(int32 InSlotIndex, const void* InProperty)
+{
+	const FSlot& Slot = GetSlot(InSlotIndex);
+
+	checkf(Slot.Property == InProperty, TEXT("A property was moved in memory while it had hooks attached."));
+
+	// Copied, resumed coroutines may detach hooks.
+	const ESimplePropertyHook Hooks = Slot.Hooks;
+
+#if SIMPLE_PROPERTIES_WITH_MIRROR
+	if (EnumHasAnyFlags(Hooks, ESimplePropertyHook::Mirror))
+	{
+		FSimplePropertyMirror::Publish(Slot.MirrorIndex, Slot.Value, Slot.ValueSize);
+	}
+#endif
+
+#if SIMPLE_PROPERTIES_WITH_JOURNAL
+	if (EnumHasAnyFlags(Hooks, ESimplePropertyHook::Journal))
+	{
+		FSimplePropertyJournal::Record(InProperty, Slot.Value, Slot.ValueSize);
+	}
+#endif
+
+#if SIMPLE_PROPERTIES_WITH_PUSH_MODEL
+	if (EnumHasAnyFlags(Hooks, ESimplePropertyHook::PushModel))
+	{
+		FSimplePropertyPushModel::MarkDirty(Slot.PushModelIndex);
+	}
+#endif
+
+	if (EnumHasAnyFlags(Hooks, ESimplePropertyHook::Buffered))
+	{
+		FSimplePropertyBuffers::MarkDirty(Slot.BufferIndex);
+	}
+
+#if SIMPLE_PROPERTIES_WITH_COROUTINES
+	// Last, resumed coroutines may set this property again or destroy it.
+	if (EnumHasAnyFlags(Hooks, ESimplePropertyHook::Await))
+	{
+		FSimplePropertyAwait::Resume(InSlotIndex);
+	}
+#endif
+}
+
+void FSimplePropertyHooks::OnDestroyed(int32 InSlotIndex, const void* InProperty)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	const ESimplePropertyHook Hooks = GetSlot(InSlotIndex).Hooks;
+
+#if SIMPLE_PROPERTIES_WITH_COROUTINES
+	// First, so the cancelled coroutines run while the rest of the hooks are still consistent.
+	if (EnumHasAnyFlags(Hooks, ESimplePropertyHook::Await))
+	{
+		FSimplePropertyAwait::Cancel(InSlotIndex);
+	}
+#endif
+
+#if SIMPLE_PROPERTIES_WITH_MIRROR
+	if (EnumHasAnyFlags(Hooks, ESimplePropertyHook::Mirror))
+	{
+		FSimplePropertyMirror::UnregisterInternal(GetSlot(InSlotIndex).MirrorIndex);
+	}
+#endif
+
+#if SIMPLE_PROPERTIES_WITH_JOURNAL
+	if (EnumHasAnyFlags(Hooks, ESimplePropertyHook::Journal))
+	{
+		FSimplePropertyJournal::UntrackInternal(InProperty);
+	}
+#endif
+
+#if SIMPLE_PROPERTIES_WITH_PUSH_MODEL
+	if (EnumHasAnyFlags(Hooks, ESimplePropertyHook::PushModel))
+	{
+		FSimplePropertyPushModel::UnregisterInternal(GetSlot(InSlotIndex).PushModelIndex);
+	}
+#endif
+
+	if (EnumHasAnyFlags(Hooks, ESimplePropertyHook::Buffered))
+	{
+		FSimplePropertyBuffers::UnregisterInternal(GetSlot(InSlotIndex).BufferIndex);
+	}
+
+	FScopeLock Lock(&HookLock);
+	FreeHookSlot(InSlotIndex);
+}
@@ -0,0 +1,115 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#include "SimplePropertyInnerPropertyCache.h"
+#include "Containers/Map.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/Class.h"
+#include "UObject/UnrealType.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace UE::SimpleProperties::Private
+{
+	struct FInnerPropertyKey
+	{
+		const UStruct* Struct;
+		FName PropertyName;
+
+		bool operator==(const FInnerPropertyKey& InOther) const
+		{
+			return Struct == InOther.Struct && PropertyName == InOther.PropertyName;
+		}
+
+		friend uint32 GetTypeHash(const FInnerPropertyKey& InKey)
+		{
+			return HashCombineFast(GetTypeHash(InKey.Struct), GetTypeHash(InKey.PropertyName));
+		}
+	};
+
+	// Property is null for names that don't exist on the struct.
+	struct FInnerProperty
+	{
+		const FProperty* Property;
+		int32 Offset;
+	};
+
+	FRWLock InnerPropertyLock;
+	TMap<FInnerPropertyKey, FInnerProperty> InnerProperties;
+
+	FDelegateHandle ReinstancingCompleteHandle;
+	FDelegateHandle ReloadCompleteHandle;
+	FDelegateHandle PostGarbageCollectHandle;
+}
+
+void FSimplePropertyInnerPropertyCache::Initialize()
+{
+	using namespace UE::SimpleProperties::Private;
+
+	ReinstancingCompleteHandle = FCoreUObjectDelegates::ReloadReinstancingCompleteDelegate.AddStatic(&FSimplePropertyInnerPropertyCache::Invalidate);
+	ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](EReloadCompleteReason)
+		{
+			Invalidate();
+		});
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddStatic(&FSimplePropertyInnerPropertyCache::Invalidate);
+}
+
+void FSimplePropertyInnerPropertyCache::Shutdown()
+{
+	using namespace UE::SimpleProperties::Private;
+
+	FCoreUObjectDelegates::ReloadReinstancingCompleteDelegate.Remove(ReinstancingCompleteHandle);
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+
+	Invalidate();
+}
+
+bool FSimplePropertyInnerPropertyCache::FindInnerPropertyInstance(const UStruct* InStruct, const void* InValue, FName InPropertyName,
+	const FProperty*& OutProp, const void*& OutData)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	if (!InStruct)
+	{
+		return false;
+	}
+
+	const FInnerPropertyKey Key = {InStruct, InPropertyName};
+	FInnerProperty InnerProperty = {nullptr, 0};
+	bool bCached = false;
+
+	{
+		FReadScopeLock ReadLock(InnerPropertyLock);
+
+		if (const FInnerProperty* Cached = InnerProperties.Find(Key))
+		{
+			InnerProperty = *Cached;
+			bCached = true;
+		}
+	}
+
+	if (!bCached)
+	{
+		InnerProperty.Property = FindFProperty<FProperty>(InStruct, InPropertyName);
+		InnerProperty.Offset = InnerProperty.Property ? InnerProperty.Property->GetOffset_ForInternal() : 0;
+
+		FWriteScopeLock WriteLock(InnerPropertyLock);
+		InnerProperties.Add(Key, InnerProperty);
+	}
+
+	if (!InnerProperty.Property)
+	{
+		return false;
+	}
+
+	OutProp = InnerProperty.Property;
+	OutData = static_cast<const uint8*>(InValue) + InnerProperty.Offset;
+	return true;
+}
+
+void FSimplePropertyInnerPropertyCache::Invalidate()
+{
+	using namespace UE::SimpleProperties::Private;
+
+	FWriteScopeLock WriteLock(InnerPropertyLock);
+	InnerProperties.Empty();
+}
@@ -0,0 +1,145 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#include "SimplePropertyInternedString.h"
+#include "Containers/Set.h"
+#include "Misc/Crc.h"
+#include "Misc/ScopeRWLock.h"
+#include "Serialization/Archive.h"
+
+namespace UE::SimpleProperties::Private
+{
+	template<typename InEntryType>
+	struct TInternedStringKeyFuncs : public BaseKeyFuncs<InEntryType*, FStringView, false>
+	{
+		static FStringView GetSetKey(const InEntryType* InEntry)
+		{
+			return InEntry->String;
+		}
+
+		static bool Matches(FStringView InA, FStringView InB)
+		{
+			return InA.Equals(InB, ESearchCase::CaseSensitive);
+		}
+
+		static uint32 GetKeyHash(FStringView InKey)
+		{
+			return FCrc::MemCrc32(InKey.GetData(), InKey.Len() * sizeof(TCHAR));
+		}
+	};
+}
+
+// Entries only leave the pool under the write lock, and only once their count has reached zero under that lock.
+// Everything that can take a count from 1 to 0 goes through the lock, so a reader holding the read lock never sees
+// an entry that is about to be freed.
+class FSimplePropertyInternedStringPool
+{
+public:
+	using FEntry = FSimplePropertyInternedString::FEntry;
+
+	static FSimplePropertyInternedStringPool& Get()
+	{
+		// Never destroyed, handles in other statics may still release entries during shutdown.
+		static FSimplePropertyInternedStringPool* Pool = new FSimplePropertyInternedStringPool();
+		return *Pool;
+	}
+
+	FEntry* Intern(FStringView InString)
+	{
+		{
+			FReadScopeLock ReadLock(Lock);
+
+			if (FEntry* const* Existing = Entries.Find(InString))
+			{
+				(*Existing)->RefCount.fetch_add(1, std::memory_order_relaxed);
+				return *Existing;
+			}
+		}
+
+		FWriteScopeLock WriteLock(Lock);
+
+		// Someone may have added it between the locks.
+		if (FEntry* const* Existing = Entries.Find(InString))
+		{
+			(*Existing)->RefCount.fetch_add(1, std::memory_order_relaxed);
+			return *Existing;
+		}
+
+		FEntry* NewEntry = new FEntry{FString(InString), 1};
+		Entries.Add(NewEntry);
+		return NewEntry;
+	}
+
+	void Release(FEntry* InEntry)
+	{
+		int32 RefCount = InEntry->RefCount.load(std::memory_order_relaxed);
+
+		// Fast path while other handles remain.
+		while (RefCount > 1)
+		{
+			if (InEntry->RefCount.compare_exchange_weak(RefCount, RefCount - 1, std::memory_order_release, std::memory_order_relaxed))
+			{
+				return;
+			}
+		}
+
+		FWriteScopeLock WriteLock(Lock);
+
+		if (InEntry->RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			Entries.Remove(FStringView(InEntry->String));
+			delete InEntry;
+		}
+	}
+
+	int32 Num()
+	{
+		FReadScopeLock ReadLock(Lock);
+		return Entries.Num();
+	}
+
+protected:
+	FRWLock Lock;
+	TSet<FEntry*, UE::SimpleProperties::Private::TInternedStringKeyFuncs<FEntry>> Entries;
+};
+
+const FString FSimplePropertyInternedString::EmptyString;
+
+FSimplePropertyInternedString::FEntry* FSimplePropertyInternedString::Intern(FStringView InString)
+{
+	if (InString.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	return FSimplePropertyInternedStringPool::Get().Intern(InString);
+}
+
+void FSimplePropertyInternedString::Release(FEntry* InEntry)
+{
+	if (InEntry)
+	{
+		FSimplePropertyInternedStringPool::Get().Release(InEntry);
+	}
+}
+
+int32 FSimplePropertyInternedString::GetNumInterned()
+{
+	return FSimplePropertyInternedStringPool::Get().Num();
+}
+
+FArchive& operator<<(FArchive& InArchive, FSimplePropertyInternedString& InString)
+{
+	if (InArchive.IsLoading())
+	{
+		FString String;
+		InArchive << String;
+		InString = FSimplePropertyInternedString(String);
+	}
+	else
+	{
+		FString String = InString.Get();
+		InArchive << String;
+	}
+
+	return InArchive;
+}
@@ -0,0 +1,327 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#include "SimplePropertyJournal.h"
+
+#if SIMPLE_PROPERTIES_WITH_JOURNAL
+
+#include "Containers/Map.h"
+#include "Containers/Queue.h"
+#include "CoreGlobals.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/ScopeLock.h"
+#include "SimplePropertiesLog.h"
+#include "Templates/UniquePtr.h"
+#include <atomic>
+
+namespace UE::SimpleProperties::Private
+{
+	using namespace UE::SimpleProperties::Journal;
+
+	// Records are buffered per thread and handed to the writer in chunks of about this size.
+	constexpr int32 JournalChunkBytes = 64 * 1024;
+
+	class FJournalWriter : public FRunnable
+	{
+	public:
+		explicit FJournalWriter(TUniquePtr<IFileHandle> InFile)
+			: File(MoveTemp(InFile))
+			, WakeEvent(FPlatformProcess::GetSynchEventFromPool())
+		{
+			Thread.Reset(FRunnableThread::Create(this, TEXT("SimplePropertyJournal"), 0, TPri_BelowNormal));
+		}
+
+		virtual ~FJournalWriter() override
+		{
+			bStopping = true;
+			WakeEvent->Trigger();
+			Thread->WaitForCompletion();
+			Thread.Reset();
+
+			// Anything submitted while the thread was exiting.
+			WriteQueued();
+			FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+		}
+
+		void Submit(TArray<uint8>&& InChunk)
+		{
+			Queue.Enqueue(MoveTemp(InChunk));
+
+			if (bWaiting.load(std::memory_order_relaxed))
+			{
+				WakeEvent->Trigger();
+			}
+		}
+
+		virtual uint32 Run() override
+		{
+			while (!bStopping)
+			{
+				bWaiting = true;
+				WakeEvent->Wait(100);
+				bWaiting = false;
+
+				WriteQueued();
+			}
+
+			return 0;
+		}
+
+	protected:
+		TUniquePtr<IFileHandle> File;
+		TUniquePtr<FRunnableThread> Thread;
+		FEvent* WakeEvent;
+		TQueue<TArray<uint8>, EQueueMode::Mpsc> Queue;
+		std::atomic<bool> bStopping = false;
+		std::atomic<bool> bWaiting = false;
+
+		void WriteQueued()
+		{
+			TArray<uint8> Chunk;
+			bool bWritten = false;
+
+			while (Queue.Dequeue(Chunk))
+			{
+				if (!File->Write(Chunk.GetData(), Chunk.Num()))
+				{
+					UE_LOG(LogSimpleProperties, Warning, TEXT("Failed to write %d bytes to the property journal."), Chunk.Num());
+				}
+
+				bWritten = true;
+			}
+
+			if (bWritten)
+			{
+				File->Flush();
+			}
+		}
+	};
+
+	struct FTrackedProperty
+	{
+		uint64 OwnerId;
+		uint32 PropertyId;
+		const void* Value;
+		int32 ValueSize;
+	};
+
+	std::atomic<bool> bJournalRecording = false;
+
+	// Bumped by every Start so buffers left over from an earlier recording are dropped instead of written.
+	std::atomic<uint32> JournalSession = 0;
+	uint64 JournalStartFrame = 0;
+
+	// Start, Stop and (un)tracking only, never the change path.
+	FCriticalSection JournalLock;
+	TUniquePtr<FJournalWriter> JournalWriter;
+	TMap<const void*, FTrackedProperty> TrackedProperties;
+	FDelegateHandle JournalEndFrameHandle;
+
+	struct FJournalThreadBuffer
+	{
+		TArray<uint8> Data;
+		uint32 Session = 0;
+
+		~FJournalThreadBuffer()
+		{
+			// The thread is exiting.
+			Submit();
+		}
+
+		void Submit()
+		{
+			if (!Data.IsEmpty())
+			{
+				FScopeLock Lock(&JournalLock);
+				SubmitLocked();
+			}
+		}
+
+		void SubmitLocked()
+		{
+			if (JournalWriter && Session == JournalSession.load(std::memory_order_relaxed) && !Data.IsEmpty())
+			{
+				JournalWriter->Submit(MoveTemp(Data));
+			}
+
+			Data.Reset();
+		}
+
+		void Append(ERecord InType, const void* InRecord, int32 InRecordSize, const void* InValue, int32 InValueSize)
+		{
+			const uint32 CurrentSession = JournalSession.load(std::memory_order_relaxed);
+
+			if (Session != CurrentSession)
+			{
+				Data.Reset();
+				Session = CurrentSession;
+			}
+
+			if (Data.Max() == 0)
+			{
+				Data.Reserve(JournalChunkBytes + 256);
+			}
+
+			Data.Add(static_cast<uint8>(InType));
+			Data.Append(static_cast<const uint8*>(InRecord), InRecordSize);
+
+			if (InValue)
+			{
+				Data.Append(static_cast<const uint8*>(InValue), InValueSize);
+			}
+		}
+	};
+
+	thread_local FJournalThreadBuffer JournalThreadBuffer;
+
+	uint32 GetJournalFrame()
+	{
+		return static_cast<uint32>(GFrameCounter - JournalStartFrame);
+	}
+
+	// Appends to the calling thread's buffer. The caller flushes it.
+	void WriteDeclare(const void* InProperty, const FTrackedProperty& InTracked)
+	{
+		const FDeclareRecord Declare{reinterpret_cast<UPTRINT>(InProperty), GetJournalFrame(), InTracked.OwnerId,
+			InTracked.PropertyId, static_cast<uint16>(InTracked.ValueSize)};
+
+		const FChangeRecord Change{reinterpret_cast<UPTRINT>(InProperty), Declare.Frame, Declare.ValueSize};
+
+		JournalThreadBuffer.Append(ERecord::Declare, &Declare, sizeof(Declare), nullptr, 0);
+		JournalThreadBuffer.Append(ERecord::Change, &Change, sizeof(Change), InTracked.Value, InTracked.ValueSize);
+	}
+}
+
+bool FSimplePropertyJournal::Start(const FString& InPath)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	FScopeLock Lock(&JournalLock);
+
+	if (JournalWriter)
+	{
+		UE_LOG(LogSimpleProperties, Warning, TEXT("The property journal is already recording."));
+		return false;
+	}
+
+	TUniquePtr<IFileHandle> File(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*InPath));
+
+	if (!File)
+	{
+		UE_LOG(LogSimpleProperties, Warning, TEXT("Failed to open the property journal %s."), *InPath);
+		return false;
+	}
+
+	JournalStartFrame = GFrameCounter;
+
+	const FFileHeader Header{Magic, Version, JournalStartFrame};
+	File->Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+
+	JournalWriter = MakeUnique<FJournalWriter>(MoveTemp(File));
+	JournalSession.fetch_add(1, std::memory_order_relaxed);
+	bJournalRecording.store(true, std::memory_order_release);
+
+	for (const TPair<const void*, FTrackedProperty>& Pair : TrackedProperties)
+	{
+		WriteDeclare(Pair.Key, Pair.Value);
+	}
+
+	JournalThreadBuffer.SubmitLocked();
+
+	JournalEndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&FSimplePropertyJournal::FlushThread);
+
+	UE_LOG(LogSimpleProperties, Log, TEXT("Recording the property journal to %s."), *InPath);
+	return true;
+}
+
+void FSimplePropertyJournal::Stop()
+{
+	using namespace UE::SimpleProperties::Private;
+
+	FlushThread();
+
+	TUniquePtr<FJournalWriter> Writer;
+
+	{
+		FScopeLock Lock(&JournalLock);
+
+		if (!JournalWriter)
+		{
+			return;
+		}
+
+		bJournalRecording.store(false, std::memory_order_release);
+		FCoreDelegates::OnEndFrame.Remove(JournalEndFrameHandle);
+		Writer = MoveTemp(JournalWriter);
+	}
+
+	// Joins the writer outside the lock, it writes out whatever was queued.
+	Writer.Reset();
+}
+
+bool FSimplePropertyJournal::IsRecording()
+{
+	return UE::SimpleProperties::Private::bJournalRecording.load(std::memory_order_relaxed);
+}
+
+void FSimplePropertyJournal::Record(const void* InProperty, const void* InValue, int32 InValueSize)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	// Acquire pairs with Start, so the start frame is visible.
+	if (!bJournalRecording.load(std::memory_order_acquire))
+	{
+		return;
+	}
+
+	const FChangeRecord Change{reinterpret_cast<UPTRINT>(InProperty), GetJournalFrame(), static_cast<uint16>(InValueSize)};
+	JournalThreadBuffer.Append(ERecord::Change, &Change, sizeof(Change), InValue, InValueSize);
+
+	if (JournalThreadBuffer.Data.Num() >= JournalChunkBytes)
+	{
+		JournalThreadBuffer.Submit();
+	}
+}
+
+void FSimplePropertyJournal::FlushThread()
+{
+	UE::SimpleProperties::Private::JournalThreadBuffer.Submit();
+}
+
+void FSimplePropertyJournal::Shutdown()
+{
+	Stop();
+
+	FScopeLock Lock(&UE::SimpleProperties::Private::JournalLock);
+	UE::SimpleProperties::Private::TrackedProperties.Empty();
+}
+
+void FSimplePropertyJournal::TrackInternal(uint64 InOwnerId, uint32 InPropertyId, const void* InProperty, const void* InValue,
+	int32 InValueSize)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	FScopeLock Lock(&JournalLock);
+
+	const FTrackedProperty& Tracked = TrackedProperties.Add(InProperty, {InOwnerId, InPropertyId, InValue, InValueSize});
+
+	if (JournalWriter)
+	{
+		// Flushed straight away so the declare isn't held back behind this thread's next chunk.
+		WriteDeclare(InProperty, Tracked);
+		JournalThreadBuffer.SubmitLocked();
+	}
+}
+
+void FSimplePropertyJournal::UntrackInternal(const void* InProperty)
+{
+	FScopeLock Lock(&UE::SimpleProperties::Private::JournalLock);
+	UE::SimpleProperties::Private::TrackedProperties.Remove(InProperty);
+}
+
+#endif
@@ -0,0 +1,196 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#include "SimplePropertyJournalReplay.h"
+
+#if SIMPLE_PROPERTIES_WITH_JOURNAL
+
+#include "Algo/StableSort.h"
+#include "Async/MappedFileHandle.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/PlatformFileManager.h"
+#include "SimplePropertiesLog.h"
+
+namespace UE::SimpleProperties::Private
+{
+	using namespace UE::SimpleProperties::Journal;
+
+	struct FJournalDeclare
+	{
+		uint32 Frame;
+		uint64 OwnerId;
+		uint32 PropertyId;
+	};
+
+	template<typename InRecordType>
+	bool ReadRecord(const uint8* InData, int64 InSize, int64& InOutOffset, InRecordType& OutRecord)
+	{
+		if (InOutOffset + static_cast<int64>(sizeof(InRecordType)) > InSize)
+		{
+			return false;
+		}
+
+		FMemory::Memcpy(&OutRecord, InData + InOutOffset, sizeof(InRecordType));
+		InOutOffset += sizeof(InRecordType);
+		return true;
+	}
+}
+
+FSimplePropertyJournalReplay::FSimplePropertyJournalReplay() = default;
+
+FSimplePropertyJournalReplay::~FSimplePropertyJournalReplay()
+{
+	Close();
+}
+
+bool FSimplePropertyJournalReplay::Open(const FString& InPath)
+{
+	Close();
+
+	MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*InPath));
+
+	if (MappedFile)
+	{
+		MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+	}
+
+	if (!MappedRegion || !Index(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize()))
+	{
+		UE_LOG(LogSimpleProperties, Warning, TEXT("Failed to open the property journal %s."), *InPath);
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void FSimplePropertyJournalReplay::Close()
+{
+	Changes.Empty();
+	NextChange = 0;
+	MappedRegion.Reset();
+	MappedFile.Reset();
+}
+
+int32 FSimplePropertyJournalReplay::ReplayTo(uint32 InFrame)
+{
+	const int32 FirstChange = NextChange;
+
+	for (; NextChange < Changes.Num() && Changes[NextChange].Frame <= InFrame; ++NextChange)
+	{
+		const FChange& Change = Changes[NextChange];
+		const FBinding* Binding = Bindings.Find(Change.Key);
+
+		if (Binding && Binding->ValueSize == Change.ValueSize)
+		{
+			Binding->Apply(Binding->Property, Change.Value);
+		}
+	}
+
+	return NextChange - FirstChange;
+}
+
+bool FSimplePropertyJournalReplay::Index(const uint8* InData, int64 InSize)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	int64 Offset = 0;
+	FFileHeader Header;
+
+	if (!ReadRecord(InData, InSize, Offset, Header) || Header.Magic != Magic || Header.Version != Version)
+	{
+		return false;
+	}
+
+	struct FPendingChange
+	{
+		uint64 Property;
+		uint32 Frame;
+		int32 ValueSize;
+		const uint8* Value;
+	};
+
+	TMap<uint64, TArray<FJournalDeclare>> Declares;
+	TArray<FPendingChange> Pending;
+
+	while (Offset < InSize)
+	{
+		const ERecord Type = static_cast<ERecord>(InData[Offset++]);
+
+		if (Type == ERecord::Declare)
+		{
+			FDeclareRecord Declare;
+
+			if (!ReadRecord(InData, InSize, Offset, Declare))
+			{
+				break;
+			}
+
+			Declares.FindOrAdd(Declare.Property).Add({Declare.Frame, Declare.OwnerId, Declare.PropertyId});
+		}
+		else if (Type == ERecord::Change)
+		{
+			FChangeRecord Change;
+
+			if (!ReadRecord(InData, InSize, Offset, Change) || Offset + Change.ValueSize > InSize)
+			{
+				break;
+			}
+
+			Pending.Add({Change.Property, Change.Frame, Change.ValueSize, InData + Offset});
+			Offset += Change.ValueSize;
+		}
+		else
+		{
+			UE_LOG(LogSimpleProperties, Warning, TEXT("Unknown record in the property journal at offset %lld, ignoring the rest."), Offset - 1);
+			break;
+		}
+	}
+
+	// A journal cut short by a crash is still played up to the last complete record.
+	if (Offset < InSize)
+	{
+		UE_LOG(LogSimpleProperties, Warning, TEXT("The property journal is truncated, replaying the first %lld of %lld bytes."), Offset, InSize);
+	}
+
+	// Declares from different threads' chunks can be out of order.
+	for (TPair<uint64, TArray<FJournalDeclare>>& Pair : Declares)
+	{
+		Algo::StableSortBy(Pair.Value, &FJournalDeclare::Frame);
+	}
+
+	Changes.Reserve(Pending.Num());
+
+	for (const FPendingChange& Change : Pending)
+	{
+		const TArray<FJournalDeclare>* AddressDeclares = Declares.Find(Change.Property);
+
+		if (!AddressDeclares)
+		{
+			continue;
+		}
+
+		// The latest declare of this address at or before the change.
+		const FJournalDeclare* Owner = nullptr;
+
+		for (const FJournalDeclare& Declare : *AddressDeclares)
+		{
+			if (Declare.Frame > Change.Frame)
+			{
+				break;
+			}
+
+			Owner = &Declare;
+		}
+
+		if (Owner)
+		{
+			Changes.Add({Change.Frame, Change.ValueSize, FBindingKey(Owner->OwnerId, Owner->PropertyId), Change.Value});
+		}
+	}
+
+	// Stable, so each thread's changes keep their order within a frame.
+	Algo::StableSortBy(Changes, &FChange::Frame);
+	return true;
+}
+
+#endif
@@ -0,0 +1,429 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#include "SimplePropertyLayout.h"
+#include "HAL/UnrealMemory.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "Templates/TypeHash.h"
+
+void FSimplePropertyLayout::OnEntryAdded(FSimplePropertyLayoutEntry& InEntry)
+{
+	if (InEntry.bTrivial)
+	{
+		InEntry.SnapshotOffset = TrivialBytes;
+		TrivialBytes += InEntry.ValueSize;
+	}
+
+	if (InEntry.bBlockSerializable)
+	{
+		InEntry.ArchiveBlockOffset = ArchiveBlockBytes;
+		ArchiveBlockBytes += InEntry.ValueSize;
+	}
+
+	LayoutHash = HashCombine(LayoutHash, GetTypeHash(InEntry.Name));
+	LayoutHash = HashCombine(LayoutHash, GetTypeHash(InEntry.ValueSize));
+}
+
+void FSimplePropertyLayout::Capture(const void* InOwner, FSimplePropertySnapshot& OutSnapshot) const
+{
+	const uint8* Owner = static_cast<const uint8*>(InOwner);
+
+	OutSnapshot.LayoutHash = LayoutHash;
+	OutSnapshot.Data.Reset();
+	OutSnapshot.Data.SetNumUninitialized(TrivialBytes);
+
+	uint8* Block = OutSnapshot.Data.GetData();
+	bool bHasArchivedEntries = false;
+
+	for (const FSimplePropertyLayoutEntry& Entry : Entries)
+	{
+		if (Entry.bTrivial)
+		{
+			FMemory::Memcpy(Block + Entry.SnapshotOffset, Owner + Entry.ValueOffset, Entry.ValueSize);
+		}
+		else
+		{
+			bHasArchivedEntries = true;
+		}
+	}
+
+	if (!bHasArchivedEntries)
+	{
+		return;
+	}
+
+	FMemoryWriter Writer(OutSnapshot.Data);
+	Writer.Seek(TrivialBytes);
+
+	for (const FSimplePropertyLayoutEntry& Entry : Entries)
+	{
+		if (!Entry.bTrivial)
+		{
+			Entry.SaveValue(Owner + Entry.PropertyOffset, Writer);
+		}
+	}
+}
+
+TBitArray<> FSimplePropertyLayout::Restore(void* InOwner, const FSimplePropertySnapshot& InSnapshot) const
+{
+	TBitArray<> Changed(false, Entries.Num());
+
+	if (!ensureMsgf(InSnapshot.LayoutHash == LayoutHash && InSnapshot.Data.Num() >= TrivialBytes,
+		TEXT("Snapshot was captured with a different property layout.")))
+	{
+		return Changed;
+	}
+
+	uint8* Owner = static_cast<uint8*>(InOwner);
+	const uint8* Block = InSnapshot.Data.GetData();
+	bool bHasArchivedEntries = false;
+
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		const FSimplePropertyLayoutEntry& Entry = Entries[Index];
+
+		if (!Entry.bTrivial)
+		{
+			bHasArchivedEntries = true;
+			continue;
+		}
+
+		uint8* Value = Owner + Entry.ValueOffset;
+		const uint8* SnapshotValue = Block + Entry.SnapshotOffset;
+
+		// Bytewise, as that's what was captured.
+		if (FMemory::Memcmp(Value, SnapshotValue, Entry.ValueSize) != 0)
+		{
+			FMemory::Memcpy(Value, SnapshotValue, Entry.ValueSize);
+			Changed[Index] = true;
+		}
+	}
+
+	if (bHasArchivedEntries)
+	{
+		FMemoryReader Reader(InSnapshot.Data);
+		Reader.Seek(TrivialBytes);
+
+		for (int32 Index = 0; Index < Entries.Num(); ++Index)
+		{
+			const FSimplePropertyLayoutEntry& Entry = Entries[Index];
+
+			if (!Entry.bTrivial && Entry.LoadValue(Owner + Entry.PropertyOffset, Reader))
+			{
+				Changed[Index] = true;
+			}
+		}
+	}
+
+	DispatchChanged(Owner, Changed, false);
+
+	return Changed;
+}
+
+void FSimplePropertyLayout::NotifyChanged(void* InOwner, const TBitArray<>& InChanged) const
+{
+	uint8* Owner = static_cast<uint8*>(InOwner);
+
+	for (TConstSetBitIterator<> It(InChanged); It; ++It)
+	{
+		const FSimplePropertyLayoutEntry& Entry = Entries[It.GetIndex()];
+		Entry.NotifyCallback(Owner + Entry.PropertyOffset);
+	}
+}
+
+void FSimplePropertyLayout::DispatchChanged(uint8* InOwner, const TBitArray<>& InChanged, bool bInCallbacks) const
+{
+	for (TConstSetBitIterator<> It(InChanged); It; ++It)
+	{
+		const FSimplePropertyLayoutEntry& Entry = Entries[It.GetIndex()];
+		void* Property = InOwner + Entry.PropertyOffset;
+
+		// The same order as a set: the callback, then the hooks.
+		if (bInCallbacks)
+		{
+			Entry.NotifyCallback(Property);
+		}
+
+		Entry.NotifyHooks(Property);
+	}
+}
+
+namespace UE::SimpleProperties::Private
+{
+	// Bump when the layout of FSimplePropertyLayout::Serialize's data changes. Older versions aren't loaded.
+	constexpr int32 LayoutArchiveVersion = 2;
+
+	// The smallest a saved entry can be: its value size and block flag, plus the name.
+	constexpr int64 MinSavedEntryBytes = sizeof(int32) * 2;
+
+	// Bounds the entry table for archives that don't know their size. No owner has anywhere near this many properties.
+	constexpr int32 MaxSavedEntries = MAX_uint16;
+
+	// What's left of the archive, or MAX_int64 if it doesn't know its size.
+	int64 GetRemainingBytes(FArchive& InArchive)
+	{
+		const int64 TotalSize = InArchive.TotalSize();
+		return TotalSize >= 0 ? TotalSize - InArchive.Tell() : MAX_int64;
+	}
+
+	// The outer archive's versions, so values serialize the same as they would into it directly.
+	void CopyVersions(const FArchive& InFrom, FArchive& InTo)
+	{
+		InTo.SetUEVer(InFrom.UEVer());
+		InTo.SetLicenseeUEVer(InFrom.LicenseeUEVer());
+		InTo.SetEngineVer(InFrom.EngineVer());
+		InTo.SetCustomVersions(InFrom.GetCustomVersions());
+	}
+
+	struct FSavedLayoutEntry
+	{
+		FName Name;
+		int32 ValueSize = 0;
+		bool bBlock = false;
+		int32 BlockOffset = INDEX_NONE;
+	};
+}
+
+TBitArray<> FSimplePropertyLayout::Serialize(FArchive& InArchive, void* InOwner, ESimplePropertyLoadNotify InNotify) const
+{
+	// The block is raw memory, it can't be swapped per field.
+	if (!ensureMsgf(!InArchive.IsByteSwapping(), TEXT("Property layouts can't be serialized with byte swapping archives.")))
+	{
+		InArchive.SetError();
+		return TBitArray<>();
+	}
+
+	if (InArchive.IsLoading())
+	{
+		return Load(InArchive, static_cast<uint8*>(InOwner), InNotify);
+	}
+
+	Save(InArchive, static_cast<const uint8*>(InOwner));
+	return TBitArray<>();
+}
+
+void FSimplePropertyLayout::Save(FArchive& InArchive, const uint8* InOwner) const
+{
+	int32 Version = UE::SimpleProperties::Private::LayoutArchiveVersion;
+	InArchive << Version;
+
+	int32 NumEntries = Entries.Num();
+	InArchive << NumEntries;
+
+	for (const FSimplePropertyLayoutEntry& Entry : Entries)
+	{
+		FName Name = Entry.Name;
+		int32 ValueSize = Entry.ValueSize;
+		bool bBlock = Entry.bBlockSerializable;
+		InArchive << Name << ValueSize << bBlock;
+	}
+
+	TArray<uint8> Block;
+	Block.SetNumUninitialized(ArchiveBlockBytes);
+
+	for (const FSimplePropertyLayoutEntry& Entry : Entries)
+	{
+		if (Entry.bBlockSerializable)
+		{
+			FMemory::Memcpy(Block.GetData() + Entry.ArchiveBlockOffset, InOwner + Entry.ValueOffset, Entry.ValueSize);
+		}
+	}
+
+	int32 BlockSize = ArchiveBlockBytes;
+	InArchive << BlockSize;
+	InArchive.Serialize(Block.GetData(), BlockSize);
+
+	// Archived values are prefixed with their size so that loading can skip ones it doesn't know any more. They're
+	// written to a scratch buffer first, as the outer archive may not be able to seek back to patch the size.
+	TArray<uint8> ValueBytes;
+
+	for (const FSimplePropertyLayoutEntry& Entry : Entries)
+	{
+		if (Entry.bBlockSerializable)
+		{
+			continue;
+		}
+
+		ValueBytes.Reset();
+
+		FMemoryWriter Writer(ValueBytes, InArchive.IsPersistent());
+		UE::SimpleProperties::Private::CopyVersions(InArchive, Writer);
+
+		FObjectAndNameAsStringProxyArchive Proxy(Writer, false);
+		Entry.SaveValue(InOwner + Entry.PropertyOffset, Proxy);
+
+		int64 NumValueBytes = ValueBytes.Num();
+		InArchive << NumValueBytes;
+		InArchive.Serialize(ValueBytes.GetData(), ValueBytes.Num());
+	}
+}
+
+TBitArray<> FSimplePropertyLayout::Load(FArchive& InArchive, uint8* InOwner, ESimplePropertyLoadNotify InNotify) const
+{
+	using namespace UE::SimpleProperties::Private;
+
+	// Suppress only skips the callbacks, hooked properties are still compared so their hooks can run.
+	const bool bCompareAll = InNotify != ESimplePropertyLoadNotify::Suppress;
+	TBitArray<> Changed(false, Entries.Num());
+
+	int32 Version = 0;
+	InArchive << Version;
+
+	if (!ensureMsgf(Version == LayoutArchiveVersion, TEXT("Unknown property layout archive version %d."), Version))
+	{
+		InArchive.SetError();
+		return TBitArray<>();
+	}
+
+	int32 NumSaved = 0;
+	InArchive << NumSaved;
+
+	if (InArchive.IsError() || NumSaved < 0 || NumSaved > MaxSavedEntries || NumSaved > GetRemainingBytes(InArchive) / MinSavedEntryBytes)
+	{
+		InArchive.SetError();
+		return TBitArray<>();
+	}
+
+	TArray<FSavedLayoutEntry> SavedEntries;
+	SavedEntries.SetNum(NumSaved);
+	int64 ExpectedBlockSize = 0;
+
+	for (FSavedLayoutEntry& Saved : SavedEntries)
+	{
+		InArchive << Saved.Name << Saved.ValueSize << Saved.bBlock;
+
+		if (InArchive.IsError() || Saved.ValueSize < 0)
+		{
+			InArchive.SetError();
+			return TBitArray<>();
+		}
+
+		if (Saved.bBlock)
+		{
+			Saved.BlockOffset = static_cast<int32>(ExpectedBlockSize);
+			ExpectedBlockSize += Saved.ValueSize;
+
+			if (ExpectedBlockSize > MAX_int32)
+			{
+				InArchive.SetError();
+				return TBitArray<>();
+			}
+		}
+	}
+
+	int32 BlockSize = 0;
+	InArchive << BlockSize;
+
+	if (InArchive.IsError() || BlockSize != ExpectedBlockSize || BlockSize > GetRemainingBytes(InArchive))
+	{
+		InArchive.SetError();
+		return TBitArray<>();
+	}
+
+	TArray<uint8> Block;
+	Block.SetNumUninitialized(BlockSize);
+	InArchive.Serialize(Block.GetData(), BlockSize);
+
+	if (InArchive.IsError())
+	{
+		return TBitArray<>();
+	}
+
+	auto FindEntryIndex = [this](FName InName)
+		{
+			return Entries.IndexOfByPredicate([InName](const FSimplePropertyLayoutEntry& InEntry)
+				{
+					return InEntry.Name == InName;
+				});
+		};
+
+	for (const FSavedLayoutEntry& Saved : SavedEntries)
+	{
+		if (!Saved.bBlock)
+		{
+			continue;
+		}
+
+		const int32 Index = FindEntryIndex(Saved.Name);
+
+		if (Index == INDEX_NONE || !Entries[Index].bBlockSerializable || Entries[Index].ValueSize != Saved.ValueSize)
+		{
+			continue;
+		}
+
+		const FSimplePropertyLayoutEntry& Entry = Entries[Index];
+		uint8* Value = InOwner + Entry.ValueOffset;
+		const uint8* SavedValue = Block.GetData() + Saved.BlockOffset;
+
+		if (!bCompareAll && !Entry.HasHooks(InOwner + Entry.PropertyOffset))
+		{
+			FMemory::Memcpy(Value, SavedValue, Saved.ValueSize);
+		}
+		else if (FMemory::Memcmp(Value, SavedValue, Saved.ValueSize) != 0)
+		{
+			FMemory::Memcpy(Value, SavedValue, Saved.ValueSize);
+			Changed[Index] = true;
+		}
+	}
+
+	// Loads one archived value from InValueArchive. Returns true if it changed.
+	auto LoadEntry = [InOwner, bCompareAll](const FSimplePropertyLayoutEntry& InEntry, FArchive& InValueArchive)
+		{
+			void* Property = InOwner + InEntry.PropertyOffset;
+
+			if (!bCompareAll && !InEntry.HasHooks(Property))
+			{
+				InEntry.StoreValue(Property, InValueArchive);
+				return false;
+			}
+
+			return InEntry.LoadValue(Property, InValueArchive);
+		};
+
+	TArray<uint8> ValueBytes;
+
+	for (const FSavedLayoutEntry& Saved : SavedEntries)
+	{
+		if (Saved.bBlock)
+		{
+			continue;
+		}
+
+		int64 NumValueBytes = 0;
+		InArchive << NumValueBytes;
+
+		if (InArchive.IsError() || NumValueBytes < 0 || NumValueBytes > MAX_int32 || NumValueBytes > GetRemainingBytes(InArchive))
+		{
+			InArchive.SetError();
+			break;
+		}
+
+		const int32 Index = FindEntryIndex(Saved.Name);
+		const bool bKnown = Index != INDEX_NONE && !Entries[Index].bBlockSerializable;
+
+		// Read whole, so an unknown or short value never leaves the outer archive mid-value.
+		ValueBytes.SetNumUninitialized(static_cast<int32>(NumValueBytes), EAllowShrinking::No);
+		InArchive.Serialize(ValueBytes.GetData(), ValueBytes.Num());
+
+		if (!bKnown || InArchive.IsError())
+		{
+			continue;
+		}
+
+		FMemoryReader Reader(ValueBytes, InArchive.IsPersistent());
+		CopyVersions(InArchive, Reader);
+
+		FObjectAndNameAsStringProxyArchive Proxy(Reader, true);
+
+		if (LoadEntry(Entries[Index], Proxy))
+		{
+			Changed[Index] = true;
+		}
+	}
+
+	// Once the whole owner is loaded, so callbacks and hooks see consistent values.
+	DispatchChanged(InOwner, Changed, InNotify == ESimplePropertyLoadNotify::Fire);
+
+	return bCompareAll ? Changed : TBitArray<>();
+}
@@ -0,0 +1,286 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#include "SimplePropertyMirror.h"
+
+#if SIMPLE_PROPERTIES_WITH_MIRROR
+
+#include "Containers/Map.h"
+#include "Containers/StringConv.h"
+#include "Containers/StringView.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformProcess.h"
+#include "Math/UnrealMathUtility.h"
+#include "Misc/ScopeLock.h"
+#include "SimplePropertiesLog.h"
+#include "UObject/NameTypes.h"
+
+namespace UE::SimpleProperties::Private
+{
+	using namespace UE::SimpleProperties::Mirror;
+
+	FPlatformMemory::FSharedMemoryRegion* MirrorRegion = nullptr;
+	FHeader* MirrorHeader = nullptr;
+	FSlot* MirrorSlots = nullptr;
+
+	// Registration only. Publishing writes the slot it was given without a lock, each slot has one writer.
+	FCriticalSection MirrorLock;
+	TArray<int32> FreeMirrorSlots;
+
+	bool OpenMirror()
+	{
+		if (MirrorRegion)
+		{
+			return true;
+		}
+
+		const FString RegionName = FString::Printf(TEXT("SimplePropertiesMirror_%u"), FPlatformProcess::GetCurrentProcessId());
+		const SIZE_T RegionSize = SlotsOffset + sizeof(FSlot) * MaxSlots;
+
+		MirrorRegion = FPlatformMemory::MapNamedSharedMemoryRegion(RegionName, true,
+			FPlatformMemory::ESharedMemoryAccess::Read | FPlatformMemory::ESharedMemoryAccess::Write, RegionSize);
+
+		if (!MirrorRegion)
+		{
+			UE_LOG(LogSimpleProperties, Warning, TEXT("Failed to create the property mirror segment %s."), *RegionName);
+			return false;
+		}
+
+		uint8* Memory = static_cast<uint8*>(MirrorRegion->GetAddress());
+		FMemory::Memzero(Memory, RegionSize);
+
+		MirrorHeader = reinterpret_cast<FHeader*>(Memory);
+		MirrorSlots = reinterpret_cast<FSlot*>(Memory + SlotsOffset);
+
+		MirrorHeader->MaxSlots = MaxSlots;
+		MirrorHeader->SlotSize = sizeof(FSlot);
+		MirrorHeader->SlotsOffset = SlotsOffset;
+		MirrorHeader->Version = Version;
+
+		// Magic last, a reader that sees it can trust the rest of the header.
+		std::atomic_thread_fence(std::memory_order_release);
+		MirrorHeader->Magic = Magic;
+
+		UE_LOG(LogSimpleProperties, Log, TEXT("Property mirror segment: %s"), *RegionName);
+		return true;
+	}
+
+	void WriteSlot(FSlot& InSlot, const void* InValue, int32 InValueSize)
+	{
+		InSlot.Sequence.fetch_add(1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		FMemory::Memcpy(InSlot.Value, InValue, InValueSize);
+		InSlot.ValueSize = InValueSize;
+		++InSlot.Generation;
+
+		InSlot.Sequence.fetch_add(1, std::memory_order_release);
+	}
+
+	/** Seqlock read, as an external reader would do it. */
+	bool ReadSlot(const FSlot& InSlot, FSlot& OutCopy)
+	{
+		for (int32 Attempt = 0; Attempt < 64; ++Attempt)
+		{
+			const uint32 Before = InSlot.Sequence.load(std::memory_order_acquire);
+
+			if (Before & 1)
+			{
+				continue;
+			}
+
+			OutCopy.ValueSize = InSlot.ValueSize;
+			OutCopy.Generation = InSlot.Generation;
+			FMemory::Memcpy(OutCopy.Name, InSlot.Name, sizeof(InSlot.Name));
+			FMemory::Memcpy(OutCopy.Type, InSlot.Type, sizeof(InSlot.Type));
+			FMemory::Memcpy(OutCopy.Value, InSlot.Value, sizeof(InSlot.Value));
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+			if (InSlot.Sequence.load(std::memory_order_relaxed) == Before)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// Strips the compiler's function signature from GetTypeName down to the template argument.
+	FAnsiStringView ExtractTypeName(const ANSICHAR* InSignature)
+	{
+		const FAnsiStringView Signature(InSignature);
+		int32 Start = INDEX_NONE;
+		int32 End = INDEX_NONE;
+
+#if defined(_MSC_VER) && !defined(__clang__)
+		Signature.FindChar('<', Start);
+		Signature.FindLastChar('>', End);
+#else
+		// "... [InType = float]"
+		static constexpr FAnsiStringView Prefix = "InType = ";
+		Start = Signature.Find(Prefix);
+		Start = Start == INDEX_NONE ? INDEX_NONE : Start + Prefix.Len() - 1;
+		Signature.FindLastChar(']', End);
+#endif
+
+		if (Start == INDEX_NONE || End == INDEX_NONE || End <= Start)
+		{
+			return Signature;
+		}
+
+		return Signature.Mid(Start + 1, End - Start - 1);
+	}
+
+	void CopyTruncated(ANSICHAR* OutBuffer, int32 InBufferLength, FAnsiStringView InString)
+	{
+		const int32 Length = FMath::Min(InString.Len(), InBufferLength - 1);
+		FMemory::Memcpy(OutBuffer, InString.GetData(), Length);
+		OutBuffer[Length] = '\0';
+	}
+
+	TMap<int32, uint64> LastDumpedGenerations;
+
+	// Reads the segment the way an external reader does: every slot up to NumSlots, skipping free ones.
+	FAutoConsoleCommand DumpMirrorCommand(
+		TEXT("SimpleProperties.DumpMirror"),
+		TEXT("Logs the mirrored property values. Pass 'changed' to only log the ones that changed since the last dump."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& InArgs)
+			{
+				const bool bChangedOnly = InArgs.Contains(TEXT("changed"));
+
+				FScopeLock Lock(&MirrorLock);
+
+				if (!MirrorHeader)
+				{
+					return;
+				}
+
+				const int32 NumSlots = static_cast<int32>(MirrorHeader->NumSlots.load(std::memory_order_acquire));
+
+				for (int32 SlotIndex = 0; SlotIndex < NumSlots; ++SlotIndex)
+				{
+					FSlot Copy;
+
+					if (!ReadSlot(MirrorSlots[SlotIndex], Copy) || Copy.Name[0] == '\0')
+					{
+						continue;
+					}
+
+					uint64& LastGeneration = LastDumpedGenerations.FindOrAdd(SlotIndex);
+
+					if (bChangedOnly && LastGeneration == Copy.Generation)
+					{
+						continue;
+					}
+
+					LastGeneration = Copy.Generation;
+
+					UE_LOG(LogSimpleProperties, Display, TEXT("%s (%s) gen %llu: %s"),
+						StringCast<TCHAR>(Copy.Name).Get(), StringCast<TCHAR>(Copy.Type).Get(), Copy.Generation,
+						*BytesToHex(Copy.Value, Copy.ValueSize));
+				}
+			}));
+}
+
+int32 FSimplePropertyMirror::RegisterInternal(const FName& InName, const ANSICHAR* InTypeName, const void* InValue,
+	int32 InValueSize)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	FScopeLock Lock(&MirrorLock);
+
+	if (!OpenMirror())
+	{
+		return INDEX_NONE;
+	}
+
+	int32 SlotIndex = INDEX_NONE;
+
+	if (!FreeMirrorSlots.IsEmpty())
+	{
+		SlotIndex = FreeMirrorSlots.Pop(EAllowShrinking::No);
+	}
+	else if (MirrorHeader->NumSlots.load(std::memory_order_relaxed) < static_cast<uint32>(MaxSlots))
+	{
+		SlotIndex = static_cast<int32>(MirrorHeader->NumSlots.load(std::memory_order_relaxed));
+	}
+	else
+	{
+		UE_LOG(LogSimpleProperties, Warning, TEXT("Property mirror is full, %s won't be mirrored."), *InName.ToString());
+		return INDEX_NONE;
+	}
+
+	FSlot& Slot = MirrorSlots[SlotIndex];
+
+	// The name and type are written inside the seqlock too, as the slot may be reused.
+	Slot.Sequence.fetch_add(1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	CopyTruncated(Slot.Name, NameLength, FAnsiStringView(StringCast<ANSICHAR>(*InName.ToString()).Get()));
+	CopyTruncated(Slot.Type, TypeLength, ExtractTypeName(InTypeName));
+	Slot.Sequence.fetch_add(1, std::memory_order_release);
+
+	WriteSlot(Slot, InValue, InValueSize);
+
+	if (SlotIndex == static_cast<int32>(MirrorHeader->NumSlots.load(std::memory_order_relaxed)))
+	{
+		MirrorHeader->NumSlots.store(SlotIndex + 1, std::memory_order_release);
+	}
+
+	return SlotIndex;
+}
+
+void FSimplePropertyMirror::UnregisterInternal(int32 InMirrorIndex)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	FScopeLock Lock(&MirrorLock);
+
+	if (!MirrorSlots || InMirrorIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	// An empty name marks a free slot for readers.
+	FSlot& Slot = MirrorSlots[InMirrorIndex];
+	Slot.Sequence.fetch_add(1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	Slot.Name[0] = '\0';
+	Slot.ValueSize = 0;
+	Slot.Sequence.fetch_add(1, std::memory_order_release);
+
+	FreeMirrorSlots.Add(InMirrorIndex);
+	LastDumpedGenerations.Remove(InMirrorIndex);
+}
+
+void FSimplePropertyMirror::Publish(int32 InMirrorIndex, const void* InValue, int32 InValueSize)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	// Only null once the module has shut down.
+	if (MirrorSlots)
+	{
+		WriteSlot(MirrorSlots[InMirrorIndex], InValue, InValueSize);
+	}
+}
+
+void FSimplePropertyMirror::Shutdown()
+{
+	using namespace UE::SimpleProperties::Private;
+
+	FScopeLock Lock(&MirrorLock);
+
+	FreeMirrorSlots.Empty();
+	LastDumpedGenerations.Empty();
+
+	if (MirrorRegion)
+	{
+		FPlatformMemory::UnmapNamedSharedMemoryRegion(MirrorRegion);
+		MirrorRegion = nullptr;
+		MirrorHeader = nullptr;
+		MirrorSlots = nullptr;
+	}
+}
+
+#endif
@@ -0,0 +1,305 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#include "SimplePropertyPropagation.h"
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "CoreGlobals.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "SimplePropertiesLog.h"
+#include "SimplePropertyCallback.h"
+
+namespace UE::SimpleProperties::Private
+{
+	int32 MaxPropagationIterations = 16;
+	FAutoConsoleVariableRef CVarMaxPropagationIterations(
+		TEXT("SimpleProperties.MaxPropagationIterations"),
+		MaxPropagationIterations,
+		TEXT("How many passes of deferred re-entrant property sets are applied in one change wave before the rest are dropped."));
+
+	int32 MaxSelfReentryDepth = 8;
+	FAutoConsoleVariableRef CVarMaxSelfReentryDepth(
+		TEXT("SimpleProperties.MaxSelfReentryDepth"),
+		MaxSelfReentryDepth,
+		TEXT("How deep a property's change callback may recurse by setting the same property before further sets are deferred."));
+
+	struct FWaveProperty
+	{
+		const void* Property;
+		const TSimplePropertyCallback<void()>* Callback;
+	};
+
+	using FWaveChain = TArray<FWaveProperty, TInlineAllocator<16>>;
+
+	struct FDeferred
+	{
+		FWaveProperty Source;
+		TUniquePtr<FSimplePropertyPropagation::FDeferredSet> Set;
+
+		// The callbacks on the stack when the set re-entered. Only captured in the last pass, for the storm log.
+		FWaveChain ReentryChain;
+	};
+
+	struct FPropagationContext
+	{
+		// Properties whose callbacks are currently on the stack, outermost first.
+		FWaveChain Chain;
+		TArray<FDeferred> Deferred;
+
+		// The pass being drained. Kept here so that a property destroyed mid-pass can drop its set.
+		TArray<FDeferred> Applying;
+		bool bDraining = false;
+
+		// The drain pass being applied, or INDEX_NONE outside a drain.
+		int32 DrainPass = INDEX_NONE;
+	};
+
+	thread_local FPropagationContext ThreadContext;
+
+	FString DescribeProperty(const FWaveProperty& InProperty)
+	{
+#if !UE_BUILD_SHIPPING
+		return FString::Printf(TEXT("0x%p -> %s"), InProperty.Property, *InProperty.Callback->Describe());
+#else
+		return FString::Printf(TEXT("0x%p"), InProperty.Property);
+#endif
+	}
+
+#if !UE_BUILD_SHIPPING
+	int32 SetsPerFrameWarningThreshold = 0;
+	FAutoConsoleVariableRef CVarSetsPerFrameWarningThreshold(
+		TEXT("SimpleProperties.SetsPerFrameWarningThreshold"),
+		SetsPerFrameWarningThreshold,
+		TEXT("Logs properties whose change callback fired more than this many times in one frame. 0 disables the tracking."));
+
+	struct FSetCount
+	{
+		int32 Count = 0;
+		// Captured when the threshold is crossed, the property may be gone by the end of the frame.
+		FString Description;
+	};
+
+	// Game thread only
+	TMap<const void*, FSetCount> SetCounts;
+	FDelegateHandle EndFrameHandle;
+
+	void CountSet(const FWaveProperty& InProperty)
+	{
+		FSetCount& SetCount = SetCounts.FindOrAdd(InProperty.Property);
+
+		if (++SetCount.Count == SetsPerFrameWarningThreshold + 1)
+		{
+			SetCount.Description = DescribeProperty(InProperty);
+		}
+	}
+
+	void ReportSetCounts()
+	{
+		for (const TPair<const void*, FSetCount>& Pair : SetCounts)
+		{
+			if (Pair.Value.Count > SetsPerFrameWarningThreshold)
+			{
+				UE_LOG(LogSimpleProperties, Warning, TEXT("Property changed %d times this frame: %s"),
+					Pair.Value.Count, *Pair.Value.Description);
+			}
+		}
+
+		SetCounts.Reset();
+	}
+#endif
+
+	void DrainDeferred(FPropagationContext& InContext)
+	{
+		InContext.bDraining = true;
+
+		for (int32 Pass = 0; !InContext.Deferred.IsEmpty(); ++Pass)
+		{
+			if (Pass >= MaxPropagationIterations)
+			{
+				UE_LOG(LogSimpleProperties, Warning,
+					TEXT("Property change storm: %d properties were still changing each other after %d passes. Dropping their pending sets, re-entered by:"),
+					InContext.Deferred.Num(), Pass);
+
+				for (const FDeferred& Deferred : InContext.Deferred)
+				{
+					// Outermost callback first, ending with the property whose set re-entered the chain.
+					FString Chain;
+
+					for (const FWaveProperty& WaveProperty : Deferred.ReentryChain)
+					{
+						Chain += DescribeProperty(WaveProperty);
+						Chain += TEXT("\n        => ");
+					}
+
+					Chain += DescribeProperty(Deferred.Source);
+
+					UE_LOG(LogSimpleProperties, Warning, TEXT("    %s"), *Chain);
+				}
+
+				InContext.Deferred.Reset();
+				break;
+			}
+
+			// Sets applied in this pass may defer more sets for the next one.
+			InContext.Applying = MoveTemp(InContext.Deferred);
+			InContext.Deferred.Reset();
+			InContext.DrainPass = Pass;
+
+			for (int32 Index = 0; Index < InContext.Applying.Num(); ++Index)
+			{
+				// Reset by Forget if the property was destroyed earlier in the pass.
+				TUniquePtr<FSimplePropertyPropagation::FDeferredSet> Set = MoveTemp(InContext.Applying[Index].Set);
+
+				if (Set.IsValid())
+				{
+					Set->Apply();
+				}
+			}
+
+			InContext.Applying.Reset();
+		}
+
+		InContext.bDraining = false;
+		InContext.DrainPass = INDEX_NONE;
+	}
+}
+
+void FSimplePropertyPropagation::Initialize()
+{
+#if !UE_BUILD_SHIPPING
+	using namespace UE::SimpleProperties::Private;
+
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&ReportSetCounts);
+#endif
+}
+
+void FSimplePropertyPropagation::Shutdown()
+{
+#if !UE_BUILD_SHIPPING
+	using namespace UE::SimpleProperties::Private;
+
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	SetCounts.Empty();
+#endif
+}
+
+bool FSimplePropertyPropagation::Enter(const void* InProperty, const TSimplePropertyCallback<void()>& InCallback)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	FPropagationContext& Context = ThreadContext;
+
+	// A callback setting its own property recurses, up to a depth.
+	int32 SelfDepth = 0;
+
+	while (SelfDepth < Context.Chain.Num() && Context.Chain[Context.Chain.Num() - 1 - SelfDepth].Property == InProperty)
+	{
+		++SelfDepth;
+	}
+
+	if (SelfDepth > 0 && SelfDepth >= MaxSelfReentryDepth)
+	{
+		return false;
+	}
+
+	for (int32 Index = 0; Index < Context.Chain.Num() - SelfDepth; ++Index)
+	{
+		if (Context.Chain[Index].Property == InProperty)
+		{
+			return false;
+		}
+	}
+
+	Context.Chain.Add({InProperty, &InCallback});
+
+#if !UE_BUILD_SHIPPING
+	if (SetsPerFrameWarningThreshold > 0 && IsInGameThread())
+	{
+		CountSet(Context.Chain.Last());
+	}
+#endif
+
+	return true;
+}
+
+void FSimplePropertyPropagation::Exit()
+{
+	using namespace UE::SimpleProperties::Private;
+
+	FPropagationContext& Context = ThreadContext;
+
+	if (!ensure(!Context.Chain.IsEmpty()))
+	{
+		return;
+	}
+
+	Context.Chain.Pop(EAllowShrinking::No);
+
+	if (Context.Chain.IsEmpty() && !Context.bDraining && !Context.Deferred.IsEmpty())
+	{
+		DrainDeferred(Context);
+	}
+}
+
+void FSimplePropertyPropagation::Forget(const void* InProperty)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	FPropagationContext& Context = ThreadContext;
+
+	Context.Deferred.RemoveAll([InProperty](const FDeferred& InDeferred)
+		{
+			return InDeferred.Source.Property == InProperty;
+		});
+
+	for (FDeferred& Deferred : Context.Applying)
+	{
+		if (Deferred.Source.Property == InProperty)
+		{
+			Deferred.Set.Reset();
+		}
+	}
+
+	// The storm log describes each callback in the chain, and this one is going away.
+	for (FDeferred& Deferred : Context.Deferred)
+	{
+		Deferred.ReentryChain.RemoveAll([InProperty](const FWaveProperty& InWaveProperty)
+			{
+				return InWaveProperty.Property == InProperty;
+			});
+	}
+}
+
+void FSimplePropertyPropagation::DeferInternal(const void* InProperty, const TSimplePropertyCallback<void()>& InCallback,
+	TUniquePtr<FDeferredSet> InSet)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	FPropagationContext& Context = ThreadContext;
+
+	// Sets deferred during the last pass are the ones a storm drops.
+	const bool bCaptureChain = Context.DrainPass >= MaxPropagationIterations - 1;
+
+	// Only the latest set for each property matters.
+	for (FDeferred& Deferred : Context.Deferred)
+	{
+		if (Deferred.Source.Property == InProperty)
+		{
+			Deferred.Set = MoveTemp(InSet);
+
+			if (bCaptureChain)
+			{
+				Deferred.ReentryChain = Context.Chain;
+			}
+
+			return;
+		}
+	}
+
+	FDeferred& Deferred = Context.Deferred.Add_GetRef({{InProperty, &InCallback}, MoveTemp(InSet)});
+
+	if (bCaptureChain)
+	{
+		Deferred.ReentryChain = Context.Chain;
+	}
+}
@@ -0,0 +1,117 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#include "SimplePropertyPushModel.h"
+
+#if SIMPLE_PROPERTIES_WITH_PUSH_MODEL
+
+#include "Containers/Array.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "SimplePropertiesLog.h"
+#include "UObject/Class.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UnrealType.h"
+#include "UObject/WeakObjectPtr.h"
+
+namespace UE::SimpleProperties::Private
+{
+	struct FPushModelEntry
+	{
+		// Null once the owner has been collected, or while the entry is free.
+		UObject* Owner;
+		TWeakObjectPtr<UObject> WeakOwner;
+		int32 RepIndex;
+	};
+
+	// Indexed by the properties' hook slots. Freed entries are reused.
+	TArray<FPushModelEntry> PushModelEntries;
+	TArray<int32> FreePushModelEntries;
+	FDelegateHandle PushModelPostGarbageCollectHandle;
+
+	void PurgePushModelEntries()
+	{
+		for (FPushModelEntry& Entry : PushModelEntries)
+		{
+			if (Entry.Owner && !Entry.WeakOwner.IsValid())
+			{
+				Entry.Owner = nullptr;
+			}
+		}
+	}
+}
+
+int32 FSimplePropertyPushModel::RegisterInternal(UObject* InOwner, FName InPropertyName)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	check(IsInGameThread());
+	check(InOwner);
+
+	const FProperty* Property = FindFProperty<FProperty>(InOwner->GetClass(), InPropertyName);
+
+	if (!Property || !Property->HasAnyPropertyFlags(CPF_Net))
+	{
+		UE_LOG(LogSimpleProperties, Warning, TEXT("%s isn't a replicated property of %s, it won't be push model."),
+			*InPropertyName.ToString(), *InOwner->GetClass()->GetName());
+
+		return INDEX_NONE;
+	}
+
+	const FPushModelEntry Entry{InOwner, InOwner, Property->RepIndex};
+
+	if (!FreePushModelEntries.IsEmpty())
+	{
+		const int32 EntryIndex = FreePushModelEntries.Pop(EAllowShrinking::No);
+		PushModelEntries[EntryIndex] = Entry;
+		return EntryIndex;
+	}
+
+	return PushModelEntries.Add(Entry);
+}
+
+void FSimplePropertyPushModel::UnregisterInternal(int32 InPushModelIndex)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	checkSlow(IsInGameThread());
+
+	if (PushModelEntries.IsValidIndex(InPushModelIndex))
+	{
+		PushModelEntries[InPushModelIndex] = {nullptr, nullptr, INDEX_NONE};
+		FreePushModelEntries.Add(InPushModelIndex);
+	}
+}
+
+void FSimplePropertyPushModel::MarkDirty(int32 InPushModelIndex)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	checkSlow(IsInGameThread());
+
+	const FPushModelEntry& Entry = PushModelEntries[InPushModelIndex];
+
+	if (Entry.Owner)
+	{
+		MARK_PROPERTY_DIRTY_UNSAFE(Entry.Owner, Entry.RepIndex);
+	}
+}
+
+void FSimplePropertyPushModel::Initialize()
+{
+	UE::SimpleProperties::Private::PushModelPostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddStatic(
+		&UE::SimpleProperties::Private::PurgePushModelEntries);
+}
+
+void FSimplePropertyPushModel::Shutdown()
+{
+	using namespace UE::SimpleProperties::Private;
+
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PushModelPostGarbageCollectHandle);
+
+	// Kept sized, properties still registered may unregister after shutdown.
+	for (FPushModelEntry& Entry : PushModelEntries)
+	{
+		Entry.Owner = nullptr;
+	}
+}
+
+#endif
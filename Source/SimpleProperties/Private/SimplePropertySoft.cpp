@@ -0,0 +1,59 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#include "SimplePropertySoft.h"
+#include "Engine/StreamableManager.h"
+#include "Templates/UniquePtr.h"
+
+namespace UE::SimpleProperties::Private
+{
+	// Created on first use rather than at static init, the manager is a GC object.
+	TUniquePtr<FStreamableManager> SoftLoadManager;
+
+	FStreamableManager& GetSoftLoadManager()
+	{
+		if (!SoftLoadManager)
+		{
+			SoftLoadManager = MakeUnique<FStreamableManager>();
+		}
+
+		return *SoftLoadManager;
+	}
+}
+
+TSharedPtr<FStreamableHandle> FSimplePropertySoftLoader::Request(const FSoftObjectPath& InPath, FOnLoaded InOnLoaded)
+{
+	check(IsInGameThread());
+
+	return UE::SimpleProperties::Private::GetSoftLoadManager().RequestAsyncLoad(InPath,
+		FStreamableDelegate::CreateLambda([OnLoaded = MoveTemp(InOnLoaded)]()
+			{
+				OnLoaded.ExecuteIfBound();
+			}),
+		FStreamableManager::DefaultAsyncLoadPriority, /* bManageActiveHandle */ false, /* bStartStalled */ false,
+		TEXT("SimpleSoftProperty"));
+}
+
+void FSimplePropertySoftLoader::Release(TSharedPtr<FStreamableHandle>& InOutHandle)
+{
+	if (!InOutHandle.IsValid())
+	{
+		return;
+	}
+
+	// Cancelling also stops the completion delegate from running.
+	if (InOutHandle->IsLoadingInProgress())
+	{
+		InOutHandle->CancelHandle();
+	}
+	else
+	{
+		InOutHandle->ReleaseHandle();
+	}
+
+	InOutHandle.Reset();
+}
+
+void FSimplePropertySoftLoader::Shutdown()
+{
+	UE::SimpleProperties::Private::SoftLoadManager.Reset();
+}
@@ -4,8 +4,13 @@
 
 #include "SimplePropertyTransactionManager.h"
 #include "CoreGlobals.h"
+#include "Editor.h"
 #include "Engine/Engine.h"
 #include "Internationalization/Text.h"
+#include "Misc/ScopeExit.h"
+#include "ScopedTransaction.h"
+#include "SimplePropertyUndo.h"
+#include "UObject/Object.h"
 
 namespace UE::SimpleProperties::Private
 {
@@ -40,6 +45,11 @@ bool FSimplePropertyTransactionManager::IsValidTransactionId(int32 InTransaction
 	return InTransactionId != InvalidTransactionId && InTransactionId >= 0;
 }
 
+UObject* FSimplePropertyTransactionManager::GetValidObject(const UObject* InObject)
+{
+	return IsValid(InObject) ? const_cast<UObject*>(InObject) : nullptr;
+}
+
 int32 FSimplePropertyTransactionManager::StartUnmanagedTransaction(const FText& InTransactionDescription, UObject* InPrimaryObject)
 {
 	using namespace UE::SimpleProperties::Private;
@@ -149,7 +159,7 @@ bool FSimplePropertyTransactionManager::CancelUnmanagedTransaction(int32 InTrans
 	if (GEditor && ensure(IsUnmanagedTransaction(InTransactionId)))
 	{
 		// No way of knowing if this was successful or not
-		GEditor->CancelTransaction(ManagedTransactionId);
+		GEditor->CancelTransaction(InTransactionId);
 		return true;
 	}
 
@@ -169,4 +179,250 @@ bool FSimplePropertyTransactionManager::EndUnmanagedTransaction(int32 InTransact
 	return false;
 }
 
+FSimplePropertyTransactionState::FSimplePropertyTransactionState(FSimplePropertyTransactionState&& InOther)
+	: TransactionId(InOther.TransactionId)
+	, UndoOwner(InOther.UndoOwner)
+	, bModifiedInTransaction(InOther.bModifiedInTransaction)
+	, bUndoRecorded(InOther.bUndoRecorded)
+{
+	InOther.Reset();
+}
+
+void FSimplePropertyTransactionState::Reset()
+{
+	TransactionId = FSimplePropertyTransactionManager::GetInvalidTransactionId();
+	UndoOwner = nullptr;
+	bModifiedInTransaction = false;
+	bUndoRecorded = false;
+}
+
+void FSimplePropertyTransactionState::RecordUndo(void* InProperty, const FSimplePropertyUndoValueOps& InOps)
+{
+	// Once per transaction; undoing restores the value from before the first set.
+	bUndoRecorded = true;
+	FSimplePropertyUndo::RecordValue(UndoOwner, InProperty, InOps);
+}
+
+bool FSimplePropertyTransactionState::StartManagedTransaction(const FText& InTransactionDescription, UObject* InObject,
+	UObject* InUndoOwner)
+{
+	if (HasTransaction())
+	{
+		return false;
+	}
+
+	const int32 NewTransactionId = FSimplePropertyTransactionManager::Get().StartManagedTransaction(
+		InTransactionDescription, InObject);
+
+	if (!FSimplePropertyTransactionManager::IsValidTransactionId(NewTransactionId))
+	{
+		return false;
+	}
+
+	if (InObject)
+	{
+		InObject->Modify();
+	}
+
+	TransactionId = NewTransactionId;
+	UndoOwner = InUndoOwner;
+	bModifiedInTransaction = false;
+	bUndoRecorded = false;
+
+	return true;
+}
+
+int32 FSimplePropertyTransactionState::StartUnmanagedTransaction(const FText& InTransactionDescription, UObject* InObject,
+	UObject* InUndoOwner)
+{
+	if (HasTransaction())
+	{
+		return FSimplePropertyTransactionManager::GetInvalidTransactionId();
+	}
+
+	const int32 NewTransactionId = FSimplePropertyTransactionManager::StartUnmanagedTransaction(
+		InTransactionDescription, InObject);
+
+	if (!FSimplePropertyTransactionManager::IsValidTransactionId(NewTransactionId))
+	{
+		return FSimplePropertyTransactionManager::GetInvalidTransactionId();
+	}
+
+	if (InObject)
+	{
+		InObject->Modify();
+	}
+
+	TransactionId = NewTransactionId;
+	UndoOwner = InUndoOwner;
+	bModifiedInTransaction = false;
+	bUndoRecorded = false;
+
+	return NewTransactionId;
+}
+
+TSharedPtr<FScopedTransaction> FSimplePropertyTransactionState::StartUnmanagedScopedTransaction(
+	const FText& InTransactionDescription, UObject* InObject)
+{
+	if (HasTransaction())
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FScopedTransaction> NewTransaction = FSimplePropertyTransactionManager::StartUnmanagedScopedTransaction(
+		InTransactionDescription, InObject);
+
+	if (!NewTransaction || !NewTransaction->IsOutstanding())
+	{
+		return nullptr;
+	}
+
+	if (InObject)
+	{
+		InObject->Modify();
+	}
+
+	bModifiedInTransaction = false;
+
+	return NewTransaction;
+}
+
+ESimplePropertyTransactionEndResult FSimplePropertyTransactionState::CancelManagedTransaction()
+{
+	ON_SCOPE_EXIT
+	{
+		Reset();
+	};
+
+	if (!HasTransaction())
+	{
+		return ESimplePropertyTransactionEndResult::Invalid;
+	}
+
+	FSimplePropertyTransactionManager& Manager = FSimplePropertyTransactionManager::Get();
+
+	if (!ensure(Manager.IsManagedTransaction(TransactionId)))
+	{
+		return ESimplePropertyTransactionEndResult::NotManaged;
+	}
+
+	if (!Manager.CancelManagedTransaction(TransactionId))
+	{
+		return ESimplePropertyTransactionEndResult::UnknownError;
+	}
+
+	return ESimplePropertyTransactionEndResult::Cancelled;
+}
+
+ESimplePropertyTransactionEndResult FSimplePropertyTransactionState::EndManagedTransaction(bool bInCancelIfUnmodified)
+{
+	ON_SCOPE_EXIT
+	{
+		Reset();
+	};
+
+	if (!HasTransaction())
+	{
+		return ESimplePropertyTransactionEndResult::Invalid;
+	}
+
+	FSimplePropertyTransactionManager& Manager = FSimplePropertyTransactionManager::Get();
+
+	if (!ensure(Manager.IsManagedTransaction(TransactionId)))
+	{
+		return ESimplePropertyTransactionEndResult::NotManaged;
+	}
+
+	if (bInCancelIfUnmodified && !bModifiedInTransaction)
+	{
+		if (!Manager.CancelManagedTransaction(TransactionId))
+		{
+			return ESimplePropertyTransactionEndResult::UnknownError;
+		}
+
+		return ESimplePropertyTransactionEndResult::Cancelled;
+	}
+
+	if (!Manager.EndManagedTransaction(TransactionId))
+	{
+		return ESimplePropertyTransactionEndResult::UnknownError;
+	}
+
+	return ESimplePropertyTransactionEndResult::Ended;
+}
+
+ESimplePropertyTransactionEndResult FSimplePropertyTransactionState::CancelUnmanagedTransaction()
+{
+	ON_SCOPE_EXIT
+	{
+		Reset();
+	};
+
+	if (!HasTransaction())
+	{
+		return ESimplePropertyTransactionEndResult::Invalid;
+	}
+
+	FSimplePropertyTransactionManager& Manager = FSimplePropertyTransactionManager::Get();
+
+	if (!ensure(Manager.IsUnmanagedTransaction(TransactionId)))
+	{
+		return ESimplePropertyTransactionEndResult::NotUnmanaged;
+	}
+
+	if (!Manager.CancelUnmanagedTransaction(TransactionId))
+	{
+		return ESimplePropertyTransactionEndResult::UnknownError;
+	}
+
+	return ESimplePropertyTransactionEndResult::Cancelled;
+}
+
+ESimplePropertyTransactionEndResult FSimplePropertyTransactionState::EndUnmanagedTransaction(bool bInCancelIfUnmodified)
+{
+	ON_SCOPE_EXIT
+	{
+		Reset();
+	};
+
+	if (!HasTransaction())
+	{
+		return ESimplePropertyTransactionEndResult::Invalid;
+	}
+
+	FSimplePropertyTransactionManager& Manager = FSimplePropertyTransactionManager::Get();
+
+	if (!ensure(Manager.IsUnmanagedTransaction(TransactionId)))
+	{
+		return ESimplePropertyTransactionEndResult::NotUnmanaged;
+	}
+
+	if (bInCancelIfUnmodified && !bModifiedInTransaction)
+	{
+		if (!Manager.CancelUnmanagedTransaction(TransactionId))
+		{
+			return ESimplePropertyTransactionEndResult::UnknownError;
+		}
+
+		return ESimplePropertyTransactionEndResult::Cancelled;
+	}
+
+	if (!Manager.EndUnmanagedTransaction(TransactionId))
+	{
+		return ESimplePropertyTransactionEndResult::UnknownError;
+	}
+
+	return ESimplePropertyTransactionEndResult::Ended;
+}
+
+bool FSimplePropertyTransactionState::HasManagedTransaction() const
+{
+	return FSimplePropertyTransactionManager::Get().IsManagedTransaction(TransactionId);
+}
+
+bool FSimplePropertyTransactionState::HasUnmanagedTransaction() const
+{
+	return FSimplePropertyTransactionManager::Get().IsUnmanagedTransaction(TransactionId);
+}
+
 #endif
@@ -0,0 +1,398 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#include "SimplePropertyTween.h"
+#include "Containers/BitArray.h"
+#include "Containers/Ticker.h"
+#include "Math/UnrealMathVectorConstants.h"
+#include "Math/VectorRegister.h"
+
+namespace UE::SimpleProperties::Private
+{
+	constexpr int32 MaxLanes = FSimplePropertyTweens::MaxLanes;
+
+	// Each ease is the cubic ((A * T + B) * T + C) * T, so every tween is eased by the same vector code.
+	struct FEaseCoefficients
+	{
+		float A;
+		float B;
+		float C;
+	};
+
+	constexpr FEaseCoefficients EaseCoefficients[] = {
+		{0.f, 0.f, 1.f},  // Linear: T
+		{0.f, 1.f, 0.f},  // EaseIn: T^2
+		{0.f, -1.f, 2.f}, // EaseOut: 1 - (1 - T)^2
+		{-2.f, 3.f, 0.f}  // EaseInOut: smoothstep
+	};
+
+	// Where a handle's tween currently is. The serial is bumped when the tween ends, so old handles stop resolving.
+	struct FTweenHandleSlot
+	{
+		int32 TweenIndex = INDEX_NONE;
+		uint32 Serial = 0;
+	};
+
+	TArray<FTweenHandleSlot> TweenHandleSlots;
+	TArray<int32> FreeTweenHandleSlots;
+
+	FSimplePropertyTweenHandle AcquireTweenHandle(int32 InTweenIndex)
+	{
+		const int32 Slot = !FreeTweenHandleSlots.IsEmpty() ? FreeTweenHandleSlots.Pop(EAllowShrinking::No) : TweenHandleSlots.AddDefaulted();
+		TweenHandleSlots[Slot].TweenIndex = InTweenIndex;
+
+		return {Slot, TweenHandleSlots[Slot].Serial};
+	}
+
+	void ReleaseTweenHandle(int32 InSlot)
+	{
+		TweenHandleSlots[InSlot].TweenIndex = INDEX_NONE;
+		++TweenHandleSlots[InSlot].Serial;
+		FreeTweenHandleSlots.Add(InSlot);
+	}
+
+	int32 ResolveTweenHandle(const FSimplePropertyTweenHandle& InHandle)
+	{
+		return TweenHandleSlots.IsValidIndex(InHandle.Slot) && TweenHandleSlots[InHandle.Slot].Serial == InHandle.Serial
+			? TweenHandleSlots[InHandle.Slot].TweenIndex
+			: INDEX_NONE;
+	}
+
+	/**
+	 * Flat arrays indexed by tween. The float arrays are padded to a multiple of 4 for the vector pass; padding and
+	 * retired entries have an inverse duration of 0, so they never finish.
+	 */
+	struct FTweenStorage
+	{
+		int32 Num = 0;
+
+		TArray<float, TAlignedHeapAllocator<16>> Elapsed;
+		TArray<float, TAlignedHeapAllocator<16>> InvDuration;
+		TArray<float, TAlignedHeapAllocator<16>> EaseA;
+		TArray<float, TAlignedHeapAllocator<16>> EaseB;
+		TArray<float, TAlignedHeapAllocator<16>> EaseC;
+		TArray<float, TAlignedHeapAllocator<16>> Alpha;
+
+		// MaxLanes per tween. Delta is To - From, Values is this tick's interpolation.
+		TArray<double> From;
+		TArray<double> To;
+		TArray<double> Delta;
+		TArray<double> Values;
+
+		TArray<void*> Properties;
+		TArray<FSimplePropertyTweens::FApplyFunction> ApplyFunctions;
+		TArray<int32> HandleSlots;
+		TArray<ESimplePropertyTweenWrite> Writes;
+
+		void Grow()
+		{
+			Elapsed.AddZeroed(4);
+			InvDuration.AddZeroed(4);
+			EaseA.AddZeroed(4);
+			EaseB.AddZeroed(4);
+			EaseC.AddZeroed(4);
+			Alpha.AddZeroed(4);
+			From.AddZeroed(4 * MaxLanes);
+			To.AddZeroed(4 * MaxLanes);
+			Delta.AddZeroed(4 * MaxLanes);
+			Values.AddZeroed(4 * MaxLanes);
+			Properties.AddZeroed(4);
+			ApplyFunctions.AddZeroed(4);
+			HandleSlots.Add(INDEX_NONE, 4);
+			Writes.AddZeroed(4);
+		}
+
+		void Move(int32 InFrom, int32 InTo)
+		{
+			Elapsed[InTo] = Elapsed[InFrom];
+			InvDuration[InTo] = InvDuration[InFrom];
+			EaseA[InTo] = EaseA[InFrom];
+			EaseB[InTo] = EaseB[InFrom];
+			EaseC[InTo] = EaseC[InFrom];
+			FMemory::Memcpy(&From[InTo * MaxLanes], &From[InFrom * MaxLanes], sizeof(double) * MaxLanes);
+			FMemory::Memcpy(&To[InTo * MaxLanes], &To[InFrom * MaxLanes], sizeof(double) * MaxLanes);
+			FMemory::Memcpy(&Delta[InTo * MaxLanes], &Delta[InFrom * MaxLanes], sizeof(double) * MaxLanes);
+			Properties[InTo] = Properties[InFrom];
+			ApplyFunctions[InTo] = ApplyFunctions[InFrom];
+			HandleSlots[InTo] = HandleSlots[InFrom];
+			Writes[InTo] = Writes[InFrom];
+
+			if (HandleSlots[InTo] != INDEX_NONE)
+			{
+				TweenHandleSlots[HandleSlots[InTo]].TweenIndex = InTo;
+			}
+		}
+
+		void Clear(int32 InIndex)
+		{
+			Elapsed[InIndex] = 0.f;
+			InvDuration[InIndex] = 0.f;
+			Properties[InIndex] = nullptr;
+			HandleSlots[InIndex] = INDEX_NONE;
+		}
+
+		/** Swaps the last tween into InIndex. */
+		void RemoveAtSwap(int32 InIndex)
+		{
+			--Num;
+
+			if (InIndex != Num)
+			{
+				Move(Num, InIndex);
+			}
+
+			Clear(Num);
+		}
+
+		bool IsFinished(int32 InIndex) const
+		{
+			return Elapsed[InIndex] * InvDuration[InIndex] >= 1.f;
+		}
+
+		FSimplePropertyTweenHandle GetHandle(int32 InIndex) const
+		{
+			const int32 Slot = HandleSlots[InIndex];
+			return {Slot, TweenHandleSlots[Slot].Serial};
+		}
+
+		void Reset()
+		{
+			for (int32 Index = 0; Index < Num; ++Index)
+			{
+				if (HandleSlots[Index] != INDEX_NONE)
+				{
+					ReleaseTweenHandle(HandleSlots[Index]);
+				}
+			}
+
+			*this = FTweenStorage();
+		}
+	};
+
+	FTweenStorage Tweens;
+	FTSTicker::FDelegateHandle TweenTickerHandle;
+
+	// Stops during a tick only unhook the tween, it's removed once the tick has finished with the arrays.
+	bool bTickingTweens = false;
+
+	// Tweens retargeted by a callback during the apply pass. Their Values were interpolated for the old target.
+	TBitArray<> RetargetedInTick;
+
+	void ApplyLanes(int32 InIndex, const double* InLanes)
+	{
+		double Lanes[MaxLanes];
+		FMemory::Memcpy(Lanes, InLanes, sizeof(Lanes));
+
+		// The callback may start tweens and grow the arrays, so nothing of the storage is referenced past here.
+		Tweens.ApplyFunctions[InIndex](Tweens.Properties[InIndex], Tweens.GetHandle(InIndex), Lanes);
+	}
+
+	void AdvanceAlphas(float InDeltaTime)
+	{
+		const VectorRegister4Float DeltaTime = VectorSetFloat1(InDeltaTime);
+
+		for (int32 Index = 0; Index < Tweens.Num; Index += 4)
+		{
+			const VectorRegister4Float Elapsed = VectorAdd(VectorLoadAligned(&Tweens.Elapsed[Index]), DeltaTime);
+			VectorStoreAligned(Elapsed, &Tweens.Elapsed[Index]);
+
+			const VectorRegister4Float T = VectorMin(VectorMultiply(Elapsed, VectorLoadAligned(&Tweens.InvDuration[Index])),
+				GlobalVectorConstants::FloatOne);
+
+			VectorRegister4Float Alpha = VectorMultiplyAdd(VectorLoadAligned(&Tweens.EaseA[Index]), T, VectorLoadAligned(&Tweens.EaseB[Index]));
+			Alpha = VectorMultiplyAdd(Alpha, T, VectorLoadAligned(&Tweens.EaseC[Index]));
+			Alpha = VectorMultiply(Alpha, T);
+
+			VectorStoreAligned(Alpha, &Tweens.Alpha[Index]);
+		}
+	}
+
+	// Every tween's lanes in one pass, before any callback runs. Tweens that only write on finish are interpolated
+	// too, a branch would cost more than the multiply-add.
+	void InterpolateLanes()
+	{
+		for (int32 Index = 0; Index < Tweens.Num; ++Index)
+		{
+			const int32 Lane = Index * MaxLanes;
+			const VectorRegister4Double Alpha = VectorSetFloat1(static_cast<double>(Tweens.Alpha[Index]));
+
+			VectorStore(VectorMultiplyAdd(VectorLoad(&Tweens.Delta[Lane]), Alpha, VectorLoad(&Tweens.From[Lane])), &Tweens.Values[Lane]);
+		}
+	}
+}
+
+void FSimplePropertyTweens::Start(FSimplePropertyTweenHandle& InOutHandle, void* InProperty, FApplyFunction InApply,
+	const double* InFrom, const double* InTo, float InDuration, ESimplePropertyEase InEase, ESimplePropertyTweenWrite InWrite)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	check(IsInGameThread());
+
+	if (InDuration <= 0.f)
+	{
+		Stop(InOutHandle);
+		InApply(InProperty, FSimplePropertyTweenHandle(), InTo);
+		return;
+	}
+
+	int32 Index = ResolveTweenHandle(InOutHandle);
+
+	if (Index == INDEX_NONE)
+	{
+		if (Tweens.Num == Tweens.Elapsed.Num())
+		{
+			Tweens.Grow();
+		}
+
+		Index = Tweens.Num++;
+		InOutHandle = AcquireTweenHandle(Index);
+		Tweens.Properties[Index] = InProperty;
+		Tweens.ApplyFunctions[Index] = InApply;
+		Tweens.HandleSlots[Index] = InOutHandle.Slot;
+	}
+	else
+	{
+		checkf(Tweens.Properties[Index] == InProperty, TEXT("A tween property was moved in memory while tweening."));
+
+		if (bTickingTweens && RetargetedInTick.IsValidIndex(Index))
+		{
+			RetargetedInTick[Index] = true;
+		}
+	}
+
+	const FEaseCoefficients& Ease = EaseCoefficients[static_cast<int32>(InEase)];
+	const int32 Lane = Index * MaxLanes;
+
+	Tweens.Elapsed[Index] = 0.f;
+	Tweens.InvDuration[Index] = 1.f / InDuration;
+	Tweens.EaseA[Index] = Ease.A;
+	Tweens.EaseB[Index] = Ease.B;
+	Tweens.EaseC[Index] = Ease.C;
+	Tweens.Writes[Index] = InWrite;
+
+	for (int32 LaneIndex = 0; LaneIndex < MaxLanes; ++LaneIndex)
+	{
+		Tweens.From[Lane + LaneIndex] = InFrom[LaneIndex];
+		Tweens.To[Lane + LaneIndex] = InTo[LaneIndex];
+		Tweens.Delta[Lane + LaneIndex] = InTo[LaneIndex] - InFrom[LaneIndex];
+	}
+}
+
+void FSimplePropertyTweens::Stop(FSimplePropertyTweenHandle& InOutHandle, bool bInSnapToTarget)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	const int32 Index = ResolveTweenHandle(InOutHandle);
+	InOutHandle = FSimplePropertyTweenHandle();
+
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	ReleaseTweenHandle(Tweens.HandleSlots[Index]);
+	Tweens.HandleSlots[Index] = INDEX_NONE;
+
+	const FApplyFunction Apply = Tweens.ApplyFunctions[Index];
+	void* const Property = Tweens.Properties[Index];
+	double Target[MaxLanes];
+	FMemory::Memcpy(Target, &Tweens.To[Index * MaxLanes], sizeof(Target));
+
+	if (bTickingTweens)
+	{
+		Tweens.InvDuration[Index] = 0.f;
+		Tweens.Properties[Index] = nullptr;
+	}
+	else
+	{
+		Tweens.RemoveAtSwap(Index);
+	}
+
+	// After the tween is gone, the callback may start or stop others.
+	if (bInSnapToTarget)
+	{
+		Apply(Property, FSimplePropertyTweenHandle(), Target);
+	}
+}
+
+bool FSimplePropertyTweens::IsActive(const FSimplePropertyTweenHandle& InHandle)
+{
+	return UE::SimpleProperties::Private::ResolveTweenHandle(InHandle) != INDEX_NONE;
+}
+
+int32 FSimplePropertyTweens::GetNumActive()
+{
+	return UE::SimpleProperties::Private::Tweens.Num;
+}
+
+void FSimplePropertyTweens::Tick(float InDeltaTime)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	if (Tweens.Num == 0 || bTickingTweens)
+	{
+		return;
+	}
+
+	bTickingTweens = true;
+
+	AdvanceAlphas(InDeltaTime);
+	InterpolateLanes();
+
+	// Tweens started by the callbacks below start advancing next frame.
+	const int32 NumToApply = Tweens.Num;
+	RetargetedInTick.Init(false, NumToApply);
+
+	for (int32 Index = 0; Index < NumToApply; ++Index)
+	{
+		// Stopped, or retargeted by an earlier callback, which restarts it from this frame's value.
+		if (!Tweens.Properties[Index] || RetargetedInTick[Index])
+		{
+			continue;
+		}
+
+		if (Tweens.IsFinished(Index))
+		{
+			// Exactly the target, whatever the rounding of the interpolation.
+			ApplyLanes(Index, &Tweens.To[Index * MaxLanes]);
+		}
+		else if (Tweens.Writes[Index] == ESimplePropertyTweenWrite::EveryFrame)
+		{
+			ApplyLanes(Index, &Tweens.Values[Index * MaxLanes]);
+		}
+	}
+
+	bTickingTweens = false;
+
+	// Retire the finished and stopped tweens. A tween retargeted by a callback has been reset and isn't finished.
+	for (int32 Index = Tweens.Num - 1; Index >= 0; --Index)
+	{
+		if (!Tweens.Properties[Index] || Tweens.IsFinished(Index))
+		{
+			if (Tweens.HandleSlots[Index] != INDEX_NONE)
+			{
+				ReleaseTweenHandle(Tweens.HandleSlots[Index]);
+			}
+
+			Tweens.RemoveAtSwap(Index);
+		}
+	}
+}
+
+void FSimplePropertyTweens::Initialize()
+{
+	UE::SimpleProperties::Private::TweenTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		TEXT("SimplePropertyTweens"), 0.f, [](float InDeltaTime)
+		{
+			Tick(InDeltaTime);
+			return true;
+		});
+}
+
+void FSimplePropertyTweens::Shutdown()
+{
+	using namespace UE::SimpleProperties::Private;
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TweenTickerHandle);
+	Tweens.Reset();
+	RetargetedInTick.Empty();
+}
@@ -0,0 +1,92 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#if WITH_EDITOR
+
+#include "SimplePropertyUndo.h"
+#include "Containers/UnrealString.h"
+#include "CoreGlobals.h"
+#include "HAL/UnrealMemory.h"
+#include "Misc/Change.h"
+#include "Misc/ITransaction.h"
+#include "Templates/UniquePtr.h"
+#include "UObject/Class.h"
+#include "UObject/Object.h"
+
+namespace UE::SimpleProperties::Private
+{
+	// Holds a copy of the value in a buffer described by the property type's ops.
+	class FUndoSwapChange : public FSwapChange
+	{
+	public:
+		FUndoSwapChange(int32 InPropertyOffset, const FSimplePropertyUndoValueOps& InOps, const void* InValue)
+			: PropertyOffset(InPropertyOffset)
+			, Ops(&InOps)
+			, Value(FMemory::Malloc(InOps.Size, InOps.Alignment))
+		{
+			Ops->CopyValue(Value, InValue);
+		}
+
+		virtual ~FUndoSwapChange() override
+		{
+			Ops->DestroyValue(Value);
+			FMemory::Free(Value);
+		}
+
+		virtual TUniquePtr<FChange> Execute(UObject* InObject) override
+		{
+			void* Property = reinterpret_cast<uint8*>(InObject) + PropertyOffset;
+
+			// The inverse holds the value we're about to replace.
+			TUniquePtr<FChange> Inverse = MakeUnique<FUndoSwapChange>(PropertyOffset, *Ops, Ops->GetValue(Property));
+
+			Ops->SetValue(Property, Value);
+
+			return Inverse;
+		}
+
+		virtual FString ToString() const override
+		{
+			return TEXT("Simple Property Change");
+		}
+
+	protected:
+		int32 PropertyOffset;
+		const FSimplePropertyUndoValueOps* Ops;
+		void* Value;
+	};
+}
+
+bool FSimplePropertyUndo::RecordValue(UObject* InOwner, void* InProperty, const FSimplePropertyUndoValueOps& InOps)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	const int32 PropertyOffset = GetPropertyOffset(InOwner, InProperty);
+
+	if (PropertyOffset == INDEX_NONE)
+	{
+		return false;
+	}
+
+	GUndo->StoreUndo(InOwner, MakeUnique<FUndoSwapChange>(PropertyOffset, InOps, InOps.GetValue(InProperty)));
+	return true;
+}
+
+int32 FSimplePropertyUndo::GetPropertyOffset(const UObject* InOwner, const void* InProperty)
+{
+	if (!GUndo || !IsValid(InOwner) || !InOwner->HasAnyFlags(RF_Transactional))
+	{
+		return INDEX_NONE;
+	}
+
+	const PTRINT Offset = static_cast<const uint8*>(InProperty) - reinterpret_cast<const uint8*>(InOwner);
+
+	if (!ensureMsgf(Offset >= 0 && Offset < InOwner->GetClass()->GetStructureSize(),
+		TEXT("Property undo can only be recorded for properties that are members of %s."), *InOwner->GetName()))
+	{
+		return INDEX_NONE;
+	}
+
+	return static_cast<int32>(Offset);
+}
+
+#endif
@@ -0,0 +1,189 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Async/Async.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "SimplePropertyBuffered.h"
+#include "Templates/Function.h"
+#include <atomic>
+
+namespace UE::SimpleProperties::Private
+{
+	// Heap-allocated text that must always match the serial, so a torn or freed read shows up as a mismatch
+	// (and as a race under a thread sanitizer build).
+	struct FBufferedTestValue
+	{
+		int32 Serial = 0;
+		FString Text = TEXT("0");
+
+		bool operator==(const FBufferedTestValue& InOther) const
+		{
+			return Serial == InOther.Serial && Text == InOther.Text;
+		}
+
+		bool IsConsistent() const
+		{
+			return Text == FString::FromInt(Serial);
+		}
+	};
+
+	constexpr int32 NumBufferedTestReaders = 4;
+
+	// Runs InRead(ReaderIndex) on the readers until the game thread work is done. Returns the number of reads per reader.
+	template<typename InReadType, typename InWorkType>
+	TArray<int64> RunBufferedReaders(InReadType&& InRead, InWorkType&& InWork)
+	{
+		std::atomic<bool> bStop = false;
+		TArray<TFuture<int64>> Readers;
+
+		for (int32 ReaderIndex = 0; ReaderIndex < NumBufferedTestReaders; ++ReaderIndex)
+		{
+			Readers.Add(Async(EAsyncExecution::Thread, [&bStop, &InRead, ReaderIndex]()
+				{
+					int64 NumReads = 0;
+
+					while (!bStop.load(std::memory_order_relaxed))
+					{
+						InRead(ReaderIndex);
+						++NumReads;
+					}
+
+					return NumReads;
+				}));
+		}
+
+		InWork();
+		bStop = true;
+
+		TArray<int64> NumReads;
+
+		for (TFuture<int64>& Reader : Readers)
+		{
+			NumReads.Add(Reader.Get());
+		}
+
+		return NumReads;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimplePropertyBufferedConcurrentReadTest, "SimpleProperties.Buffered.ConcurrentReads",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FSimplePropertyBufferedConcurrentReadTest::RunTest(const FString& InParameters)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	TSimpleBufferedProperty<FBufferedTestValue> Property;
+	std::atomic<int32> NumInconsistent = 0;
+	std::atomic<int32> NumBackwards = 0;
+	int32 LastSerials[NumBufferedTestReaders] = {};
+
+	RunBufferedReaders(
+		[&](int32 InReaderIndex)
+		{
+			Property.ReadWith([&](const FBufferedTestValue& InValue)
+				{
+					if (!InValue.IsConsistent())
+					{
+						++NumInconsistent;
+					}
+				});
+
+			// Each reader sees the value that's current when it reads, so its reads never go backwards.
+			const int32 Serial = Property.Read().Serial;
+
+			if (Serial < LastSerials[InReaderIndex])
+			{
+				++NumBackwards;
+			}
+
+			LastSerials[InReaderIndex] = Serial;
+		},
+		[&]()
+		{
+			for (int32 Serial = 1; Serial <= 100000; ++Serial)
+			{
+				Property = FBufferedTestValue{Serial, FString::FromInt(Serial)};
+				FSimplePropertyBuffers::Publish();
+			}
+		});
+
+	// Nothing reads any more, so the last value always gets published.
+	FSimplePropertyBuffers::Publish();
+
+	TestEqual(TEXT("Inconsistent reads"), NumInconsistent.load(), 0);
+	TestEqual(TEXT("Last published serial"), Property.Read().Serial, 100000);
+	TestEqual(TEXT("Reads behind a previous read"), NumBackwards.load(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimplePropertyBufferedReadThroughputTest, "SimpleProperties.Buffered.ReadThroughput",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FSimplePropertyBufferedReadThroughputTest::RunTest(const FString& InParameters)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	TSimpleBufferedProperty<FVector> Property;
+	constexpr double Seconds = 1.0;
+
+	auto Measure = [&](const TCHAR* InLabel, TFunctionRef<void()> InWork)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+
+			const TArray<int64> NumReads = RunBufferedReaders(
+				[&Property](int32 InReaderIndex)
+				{
+					Property.Read();
+				},
+				InWork);
+
+			const double Elapsed = FPlatformTime::Seconds() - StartTime;
+			int64 TotalReads = 0;
+
+			for (const int64 ReaderReads : NumReads)
+			{
+				TotalReads += ReaderReads;
+			}
+
+			AddInfo(FString::Printf(TEXT("%s: %d readers, %.1f M reads/s total, %.1f M reads/s per reader."), InLabel,
+				NumBufferedTestReaders, TotalReads / Elapsed / 1e6, TotalReads / Elapsed / 1e6 / NumBufferedTestReaders));
+		};
+
+	Measure(TEXT("No publishes"), [&]()
+		{
+			FPlatformProcess::Sleep(Seconds);
+		});
+
+	int32 NumPublishes = 0;
+
+	// A 60 Hz publish, the expected use.
+	Measure(TEXT("Publish every 16ms"), [&]()
+		{
+			for (double EndTime = FPlatformTime::Seconds() + Seconds; FPlatformTime::Seconds() < EndTime; ++NumPublishes)
+			{
+				Property = FVector(NumPublishes);
+				FSimplePropertyBuffers::Publish();
+				FPlatformProcess::Sleep(0.016f);
+			}
+		});
+
+	// The worst case, every read races a flip.
+	Measure(TEXT("Publish continuously"), [&]()
+		{
+			for (double EndTime = FPlatformTime::Seconds() + Seconds; FPlatformTime::Seconds() < EndTime; ++NumPublishes)
+			{
+				Property = FVector(NumPublishes);
+				FSimplePropertyBuffers::Publish();
+			}
+		});
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,133 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HAL/PlatformTime.h"
+#include "SimplePropertyTween.h"
+#include "Templates/UniquePtr.h"
+
+namespace UE::SimpleProperties::Private
+{
+	constexpr int32 NumBenchmarkTweens = 50000;
+	constexpr int32 NumBenchmarkTicks = 100;
+
+	// Starts NumBenchmarkTweens tweens that outlast the ticks, then times the ticks.
+	template<typename InValueType>
+	void BenchmarkTweens(FAutomationTestBase& InTest, const TCHAR* InTypeName, const InValueType& InTarget,
+		ESimplePropertyTweenWrite InWrite)
+	{
+		// Allocated once, tweening properties must not move.
+		TUniquePtr<TSimpleTweenProperty<InValueType>[]> Properties = MakeUnique<TSimpleTweenProperty<InValueType>[]>(NumBenchmarkTweens);
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		for (int32 Index = 0; Index < NumBenchmarkTweens; ++Index)
+		{
+			Properties[Index].TweenTo(InTarget, 1000.f, ESimplePropertyEase::EaseInOut, InWrite);
+		}
+
+		const double StartedTime = FPlatformTime::Seconds();
+
+		for (int32 Tick = 0; Tick < NumBenchmarkTicks; ++Tick)
+		{
+			FSimplePropertyTweens::Tick(1.f / 60.f);
+		}
+
+		const double TickedTime = FPlatformTime::Seconds();
+
+		InTest.AddInfo(FString::Printf(TEXT("%d %s tweens, %s: start %.3f ms, tick %.3f ms."), NumBenchmarkTweens, InTypeName,
+			InWrite == ESimplePropertyTweenWrite::EveryFrame ? TEXT("every frame") : TEXT("on finish"),
+			(StartedTime - StartTime) * 1000.0, (TickedTime - StartedTime) * 1000.0 / NumBenchmarkTicks));
+
+		InTest.TestTrue(TEXT("Tweens still running"), Properties[NumBenchmarkTweens - 1].IsTweening());
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimplePropertyTweenFinishTest, "SimpleProperties.Tween.Finish",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FSimplePropertyTweenFinishTest::RunTest(const FString& InParameters)
+{
+	TSimpleTweenProperty<float> Property(0.f);
+	TSimpleTweenProperty<float> Retired(0.f);
+
+	// Retiring the first tween swaps the second into its place, the second's handle must still resolve.
+	Retired.TweenTo(1.f, 0.5f, ESimplePropertyEase::Linear);
+	Property.TweenTo(1.f, 1.f, ESimplePropertyEase::Linear);
+
+	FSimplePropertyTweens::Tick(0.75f);
+
+	TestFalse(TEXT("Retired tween"), Retired.IsTweening());
+	TestEqual(TEXT("Retired value"), *Retired, 1.f);
+	TestTrue(TEXT("Moved tween"), Property.IsTweening());
+	TestEqual(TEXT("Moved value"), *Property, 0.75f);
+
+	FSimplePropertyTweens::Tick(0.5f);
+
+	TestFalse(TEXT("Finished tween"), Property.IsTweening());
+	TestEqual(TEXT("Finished value"), *Property, 1.f);
+
+	Property.TweenTo(2.f, 1.f);
+	Property.StopTween(true);
+
+	TestFalse(TEXT("Stopped tween"), Property.IsTweening());
+	TestEqual(TEXT("Snapped value"), *Property, 2.f);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimplePropertyTweenRetargetTest, "SimpleProperties.Tween.Retarget",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FSimplePropertyTweenRetargetTest::RunTest(const FString& InParameters)
+{
+	TSimpleTweenProperty<float> Second(0.f);
+	bool bRetargeted = false;
+
+	// Applied first, and retargets the later tween in the same pass.
+	TSimpleTweenProperty<float> First(FSimplePropertyOnChange(FSimplePropertyOnChange::FCallback::CreateLambda([&Second, &bRetargeted]()
+		{
+			if (!bRetargeted)
+			{
+				bRetargeted = true;
+				Second.TweenTo(10.f, 1.f, ESimplePropertyEase::Linear);
+			}
+		})));
+
+	First.TweenTo(1.f, 1.f, ESimplePropertyEase::Linear);
+	Second.TweenTo(1.f, 1.f, ESimplePropertyEase::Linear);
+
+	FSimplePropertyTweens::Tick(0.5f);
+
+	TestTrue(TEXT("Retargeted"), bRetargeted);
+	TestEqual(TEXT("Retargeted value isn't overwritten"), *Second, 0.f);
+
+	FSimplePropertyTweens::Tick(0.5f);
+
+	TestEqual(TEXT("Retargeted tween advances"), *Second, 5.f);
+
+	Second.StopTween();
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSimplePropertyTweenBenchmarkTest, "SimpleProperties.Tween.Benchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FSimplePropertyTweenBenchmarkTest::RunTest(const FString& InParameters)
+{
+	using namespace UE::SimpleProperties::Private;
+
+	for (const ESimplePropertyTweenWrite Write : {ESimplePropertyTweenWrite::EveryFrame, ESimplePropertyTweenWrite::OnFinish})
+	{
+		BenchmarkTweens(*this, TEXT("float"), 1.f, Write);
+		BenchmarkTweens(*this, TEXT("FVector"), FVector(1.0), Write);
+		BenchmarkTweens(*this, TEXT("FLinearColor"), FLinearColor::White, Write);
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,108 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/ContainersFwd.h"
+#include "CoreTypes.h"
+
+// Forward declarations for headers that only need to name the property types.
+// Include SimpleProperty.h where the properties are actually used.
+
+// Bytes available to a callback for its function, object and payload before it has to go on the heap.
+// Override in your Target/Build.cs (PublicDefinitions) if your typical payloads are larger.
+#ifndef SIMPLE_PROPERTIES_CALLBACK_INLINE_BYTES
+#define SIMPLE_PROPERTIES_CALLBACK_INLINE_BYTES 48
+#endif
+
+// Registered properties can be mirrored into shared memory for external tools (SimplePropertyMirror.h).
+#ifndef SIMPLE_PROPERTIES_WITH_MIRROR
+#define SIMPLE_PROPERTIES_WITH_MIRROR !UE_BUILD_SHIPPING
+#endif
+
+// Tracked properties can record their changes to a journal for deterministic replay (SimplePropertyJournal.h).
+// Off in shipping like the mirror; define it as 1 in your Target.cs to record shipping sessions.
+#ifndef SIMPLE_PROPERTIES_WITH_JOURNAL
+#define SIMPLE_PROPERTIES_WITH_JOURNAL !UE_BUILD_SHIPPING
+#endif
+
+// Properties can be awaited from C++20 coroutines (SimplePropertyAwait.h).
+#ifndef SIMPLE_PROPERTIES_WITH_COROUTINES
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define SIMPLE_PROPERTIES_WITH_COROUTINES 1
+#else
+#define SIMPLE_PROPERTIES_WITH_COROUTINES 0
+#endif
+#endif
+
+// Registered properties mark their replicated field dirty for push-model replication (SimplePropertyPushModel.h).
+// Defined by SimpleProperties.Build.cs from the target's push model setting.
+#ifndef SIMPLE_PROPERTIES_WITH_PUSH_MODEL
+#define SIMPLE_PROPERTIES_WITH_PUSH_MODEL 0
+#endif
+
+namespace UE::SimpleProperties
+{
+	using NoType = decltype(nullptr);
+}
+
+enum class ESimplePropertyChangeEventType : uint8;
+
+template<typename InFunctionType, uint32 InInlineBytes = SIMPLE_PROPERTIES_CALLBACK_INLINE_BYTES>
+class TSimplePropertyCallback;
+
+struct FSimplePropertyAccess;
+struct FSimplePropertyBulk;
+struct FSimplePropertyHistoryHandle;
+struct FSimplePropertyOnChange;
+
+class FSimplePropertyAwait;
+class FSimplePropertyBuffers;
+class FSimplePropertyHistory;
+class FSimplePropertyHooks;
+class FSimplePropertyInternedString;
+class FSimplePropertyJournal;
+class FSimplePropertyJournalReplay;
+class FSimplePropertyMirror;
+class FSimplePropertyPushModel;
+class FSimplePropertyLayout;
+
+template<typename InValueType>
+struct TSimplePropertyTypeTraits;
+
+#if SIMPLE_PROPERTIES_WITH_COROUTINES
+struct FSimplePropertyAwaitNode;
+struct FSimplePropertyAwaitResume;
+
+template<typename InPropertyType>
+class TSimplePropertyChangeAwaiter;
+
+template<typename InPropertyType, typename InPredicateType>
+class TSimplePropertyUntilAwaiter;
+#endif
+
+template<typename InValueType>
+struct TSimplePropertyBase;
+
+template<typename InValueType, typename InPrivateType = UE::SimpleProperties::NoType>
+struct TSimpleConstProperty;
+
+template<typename InValueType, typename InPrivateType = UE::SimpleProperties::NoType>
+struct TSimpleProperty;
+
+template<typename InValueType>
+struct TSimpleSparseProperty;
+
+template<typename InFlagType, typename InStorageType = uint32>
+struct TSimpleFlagsProperty;
+
+template<typename InSoftPtrType>
+struct TSimpleSoftProperty;
+
+template<typename InElementType, typename InAllocatorType = FDefaultAllocator>
+struct TSimpleArrayProperty;
+
+template<typename InKeyType, typename InValueType>
+struct TSimpleMapProperty;
+
+template<typename InElementType>
+struct TSimpleSetProperty;
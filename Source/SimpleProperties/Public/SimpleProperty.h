@@ -2,34 +2,36 @@
 
 #pragma once
 
+#include "SimplePropertiesFwd.h"
 #include "SimplePropertyConcepts.h"
 #include "SimplePropertyEvents.h"
+#include "SimplePropertyHooks.h"
+#include "SimplePropertyPropagation.h"
 #include "SimplePropertyTypeTraits.h"
+#include "Templates/AndOrNot.h"
 #include "Templates/Models.h"
-#include "Templates/UnrealTypeTraits.h"
-#include "UObject/Class.h"
-
+#include "Templates/Requires.h"
+#include "Templates/UnrealTemplate.h"
+#include <new>
+#include <type_traits>
+
+// Archive, GC and struct-ops support live in SimplePropertyArchive.h, SimplePropertyObjectTraits.h and
+// SimplePropertyStructOps.h. The optional features (SimplePropertyAwait.h, SimplePropertyBuffered.h,
+// SimplePropertyJournal.h, SimplePropertyMirror.h and SimplePropertyPushModel.h) only reach the property through
+// SimplePropertyHooks.h. Only include them where they are used.
 #if WITH_EDITOR
-#include "Internationalization/Text.h"
 #include "SimplePropertyTransactionManager.h"
 #endif
 
-namespace UE::SimpleProperties
-{
-	using NoType = decltype(nullptr);
-}
+class FArchive;
+class FName;
+class FProperty;
+class FReferenceCollector;
+class UObject;
 
 #if WITH_EDITOR
-enum class ESimplePropertyTransactionEndResult : uint8
-{
-	Cancelled,
-	Ended,
-	Invalid,
-	NotManaged,
-	NotUnmanaged,
-	UnknownError,
-	FirstError = Invalid
-};
+class FScopedTransaction;
+class FText;
 #endif
 
 enum class ESimplePropertyChangeEventType : uint8
@@ -50,11 +52,7 @@ struct TSimplePropertyBase
 
 	TSimplePropertyBase()
 	{
-		static_assert(TOr<
-				TIsPointer<FValueType>,
-				TNot<TIsDerivedFrom<typename TRemovePointer<FValueType>::Type, UObject>>
-			>::Value
-		);
+		static_assert(std::is_pointer_v<FValueType> || !std::is_base_of_v<UObject, std::remove_pointer_t<FValueType>>);
 	}
 
 	TSimplePropertyBase(const TSimplePropertyBase& InOther)
@@ -94,11 +92,9 @@ struct TSimplePropertyBase
 		return FValueTypes::GetPointerValue(Value);
 	}
 
-	friend FArchive& operator<<(FArchive& InArchive, const TSimplePropertyBase& InProperty)
-	{
-		InArchive << InProperty.Value;
-		return InArchive;
-	}
+	// Defined in SimplePropertyArchive.h
+	template<typename InArchiveValueType>
+	friend FArchive& operator<<(FArchive& InArchive, TSimplePropertyBase<InArchiveValueType>& InProperty);
 
 	void AddStructReferencedObjects(FReferenceCollector& InCollector)
 	{
@@ -112,23 +108,27 @@ struct TSimplePropertyBase
 	}
 
 protected:
+	friend struct FSimplePropertyAccess;
+
 	FValueType Value;
 };
 
 // Const property that requires a private key type to set (define in owning class)
-template<typename InValueType, 
-	typename InPrivateType = UE::SimpleProperties::NoType
-	UE_REQUIRES(TOr<TOr<
+template<typename InValueType, typename InPrivateType>
+struct TSimpleConstProperty : public TSimplePropertyBase<InValueType>
+{
+	// Checked here rather than in the template parameters so the type can be forward declared (SimplePropertiesFwd.h)
+	static_assert(TOr<TOr<
 			TModels<CEqualityComparable, InValueType>,
 			TModels<CEqualityEquals, InValueType>>,
 			TModels<CEqualityEqualTo, InValueType>>
-		::Value)>
-	struct TSimpleConstProperty : public TSimplePropertyBase<InValueType>
-{
+		::Value);
+
 	using Base = TSimplePropertyBase<InValueType>;
 	using FValueType = Base::template FValueType;
 	using FPrivateType = InPrivateType;
 	using FComparatorType = TSimplePropertyTypeTraits<FValueType>::template FComparatorType;
+	using FOnCallback = FSimplePropertyOnChange::FCallback;
 
 #if WITH_EDITOR
 	using FTransactionObjectType = TSimplePropertyTypeTraits<FValueType>::template FTransactionObjectType;
@@ -136,7 +136,7 @@ template<typename InValueType,
 
 	TSimpleConstProperty()
 		: Base()
-		, OnChangeDelegate(FSimplePropertyOnChange::FDelegate())
+		, OnChangeDelegate()
 		, bHasOnChange(false)
 	{
 	}
@@ -145,9 +145,6 @@ template<typename InValueType,
 		: Base(InOther.Value)
 		, OnChangeDelegate(InOther.OnChangeDelegate)
 		, bHasOnChange(OnChangeDelegate.IsBound())
-#if WITH_EDITOR
-		, bModifiedInTransaction(InOther.bModifiedInTransaction)
-#endif
 	{
 	}
 
@@ -156,8 +153,7 @@ template<typename InValueType,
 		, OnChangeDelegate(MoveTemp(InOther.OnChangeDelegate))
 		, bHasOnChange(OnChangeDelegate.IsBound())
 #if WITH_EDITOR
-		, TransactionId(InOther.TransactionId)
-		, bModifiedInTransaction(InOther.bModifiedInTransaction)
+		, TransactionState(MoveTemp(InOther.TransactionState))
 #endif
 	{
 	}
@@ -173,7 +169,7 @@ template<typename InValueType,
 		UE_REQUIRES(std::negation_v<std::is_same<InAssignType, FSimplePropertyOnChange>>)>
 	TSimpleConstProperty(const InAssignType& InDefaultValue)
 		: Base(InDefaultValue)
-		, OnChangeDelegate(FSimplePropertyOnChange::FDelegate())
+		, OnChangeDelegate()
 		, bHasOnChange(false)
 	{
 	}
@@ -182,8 +178,8 @@ template<typename InValueType,
 		UE_REQUIRES(std::negation_v<std::is_same<InAssignType, FSimplePropertyOnChange>>)>
 	TSimpleConstProperty(InAssignType&& InDefaultValue)
 		: Base(Forward<InAssignType>(InDefaultValue))
-		, OnChangeDelegate(FSimplePropertyOnChange::FDelegate())
-		, bHasOnChange(OnChangeDelegate.IsBound())
+		, OnChangeDelegate()
+		, bHasOnChange(false)
 	{
 	}
 
@@ -217,7 +213,7 @@ template<typename InValueType,
 	bool Set(FPrivateType Private, InAssignType&& InValue)
 	{
 		static_assert(!std::is_same_v<FPrivateType, UE::SimpleProperties::NoType>);
-		return SetInternal(MoveTemp(InValue));
+		return SetInternal(Forward<InAssignType>(InValue));
 	}
 
 	template<typename InAssignType>
@@ -255,262 +251,177 @@ template<typename InValueType,
 		}
 
 #if WITH_EDITOR
-		if (FSimplePropertyTransactionManager::IsValidTransactionId(TransactionId))
+		TransactionState.MarkModified();
+#endif
+
+		// Mirror, journal, push model, buffering and awaiting. Last, resumed coroutines may set or destroy this property.
+		if (bHasHooks)
 		{
-			bModifiedInTransaction = true;
+			FSimplePropertyHooks::OnChanged(HookSlot, this);
 		}
-#endif
 	}
 
-	void SetOnChange(FSimplePropertyOnChange::FDelegate InCallback)
+	void SetOnChange(FSimplePropertyOnChange InCallback)
 	{
-		OnChangeDelegate = InCallback;
+		OnChangeDelegate = MoveTemp(InCallback.Callback);
 		bHasOnChange = OnChangeDelegate.IsBound();
 	}
 
-#if WITH_EDITOR
-	bool StartManagedTransaction(const FText& InTransactionDescription)
+	// Drops deferred sets, resumes waiting coroutines with a cancelled result and detaches the other hooks.
+	~TSimpleConstProperty()
 	{
-		if (FSimplePropertyTransactionManager::IsValidTransactionId(TransactionId))
-		{
-			return false;
-		}
-
-		UObject* Object = FTransactionObjectType::GetTransactionObject(Base::Value);
-
-		const int32 NewTransactionId = FSimplePropertyTransactionManager::Get().StartManagedTransaction(
-			InTransactionDescription, Object);
-
-		if (!FSimplePropertyTransactionManager::IsValidTransactionId(NewTransactionId))
+		if (bHasDeferred)
 		{
-			return false;
+			FSimplePropertyPropagation::Forget(this);
 		}
 
-		if (Object)
+		if (bHasHooks)
 		{
-			Object->Modify();
+			FSimplePropertyHooks::OnDestroyed(HookSlot, this);
 		}
-
-		TransactionId = NewTransactionId;
-		bModifiedInTransaction = false;
-
-		return true;
 	}
 
-	UE_NODISCARD int32 StartUnmanagedTransaction(const FText& InTransactionDescription)
+#if SIMPLE_PROPERTIES_WITH_COROUTINES
+	/**
+	 * if (co_await Property.NextChange()) - true once the value changes, false if the property is destroyed first.
+	 * Sets aren't compared while no change callback is bound, so any set counts as a change.
+	 * The awaiters are defined in SimplePropertyAwait.h, include it where properties are awaited.
+	 */
+	UE_NODISCARD TSimplePropertyChangeAwaiter<TSimpleConstProperty> NextChange()
 	{
-		if (FSimplePropertyTransactionManager::IsValidTransactionId(TransactionId))
-		{
-			return FSimplePropertyTransactionManager::GetInvalidTransactionId();
-		}
-
-		UObject* Object = FTransactionObjectType::GetTransactionObject(Base::Value);
-
-		const int32 NewTransactionId = FSimplePropertyTransactionManager::Get().StartUnmanagedTransaction(
-			InTransactionDescription, Object);
-
-		if (!FSimplePropertyTransactionManager::IsValidTransactionId(NewTransactionId))
-		{
-			return FSimplePropertyTransactionManager::GetInvalidTransactionId();
-		}
+		return TSimplePropertyChangeAwaiter<TSimpleConstProperty>(*this);
+	}
 
-		if (Object)
-		{
-			Object->Modify();
-		}
+	/** co_await Property.Until([](const FValueType& InValue) { ... }) - true once the predicate holds. */
+	template<typename InPredicateType>
+	UE_NODISCARD TSimplePropertyUntilAwaiter<TSimpleConstProperty, std::decay_t<InPredicateType>> Until(InPredicateType&& InPredicate)
+	{
+		return TSimplePropertyUntilAwaiter<TSimpleConstProperty, std::decay_t<InPredicateType>>(*this,
+			std::decay_t<InPredicateType>(Forward<InPredicateType>(InPredicate)));
+	}
+#endif
 
-		TransactionId = NewTransactionId;
-		bModifiedInTransaction = false;
+#if WITH_EDITOR
+	/**
+	 * With an undo owner (the transactional object this property is a member of), the first set inside the
+	 * transaction records the old value as per-property undo on it, without Modify()ing the owner.
+	 */
+	bool StartManagedTransaction(const FText& InTransactionDescription, UObject* InUndoOwner = nullptr)
+	{
+		return TransactionState.StartManagedTransaction(InTransactionDescription, GetTransactionObject(), InUndoOwner);
+	}
 
-		return true;
+	UE_NODISCARD int32 StartUnmanagedTransaction(const FText& InTransactionDescription, UObject* InUndoOwner = nullptr)
+	{
+		return TransactionState.StartUnmanagedTransaction(InTransactionDescription, GetTransactionObject(), InUndoOwner);
 	}
 
 	// Has no local tracking support!
 	UE_NODISCARD TSharedPtr<FScopedTransaction> StartUnmanagedScopedTransaction(const FText& InTransactionDescription)
 	{
-		if (FSimplePropertyTransactionManager::IsValidTransactionId(TransactionId))
-		{
-			return nullptr;
-		}
-
-		UObject* Object = FTransactionObjectType::GetTransactionObject(Base::Value);
-
-		TSharedPtr<FScopedTransaction> NewTransaction = FSimplePropertyTransactionManager::Get().StartUnmanagedScopedTransaction(
-			InTransactionDescription, Object);
-
-		if (!NewTransaction || !NewTransaction->IsOutstanding())
-		{
-			return nullptr;
-		}
-
-		if (Object)
-		{
-			Object->Modify();
-		}
-
-		bModifiedInTransaction = false;
-
-		return NewTransaction;
+		return TransactionState.StartUnmanagedScopedTransaction(InTransactionDescription, GetTransactionObject());
 	}
 
 	ESimplePropertyTransactionEndResult CancelManagedTransaction()
 	{
-		bModifiedInTransaction = false;
-
-		if (!FSimplePropertyTransactionManager::IsValidTransactionId(TransactionId))
-		{
-			TransactionId = FSimplePropertyTransactionManager::GetInvalidTransactionId();
-			return ESimplePropertyTransactionEndResult::Invalid;
-		}
-
-		if (!ensure(FSimplePropertyTransactionManager::Get().IsManagedTransaction(TransactionId)))
-		{
-			TransactionId = FSimplePropertyTransactionManager::GetInvalidTransactionId();
-			return ESimplePropertyTransactionEndResult::NotManaged;
-		}
-
-		if (!FSimplePropertyTransactionManager::Get().CancelManagedTransaction(TransactionId))
-		{
-			TransactionId = FSimplePropertyTransactionManager::GetInvalidTransactionId();
-			return ESimplePropertyTransactionEndResult::UnknownError;
-		}
-
-		TransactionId = FSimplePropertyTransactionManager::GetInvalidTransactionId();
-		return ESimplePropertyTransactionEndResult::Cancelled;
+		return TransactionState.CancelManagedTransaction();
 	}
 
 	ESimplePropertyTransactionEndResult EndManagedTransaction(bool bInCancelIfUnmodified = false)
 	{
-		if (!FSimplePropertyTransactionManager::IsValidTransactionId(TransactionId))
-		{
-			bModifiedInTransaction = false;
-			TransactionId = FSimplePropertyTransactionManager::GetInvalidTransactionId();
-			return ESimplePropertyTransactionEndResult::Invalid;
-		}
-
-		if (!ensure(FSimplePropertyTransactionManager::Get().IsManagedTransaction(TransactionId)))
-		{
-			bModifiedInTransaction = false;
-			TransactionId = FSimplePropertyTransactionManager::GetInvalidTransactionId();
-			return ESimplePropertyTransactionEndResult::NotManaged;
-		}
-
-		if (bInCancelIfUnmodified && !bModifiedInTransaction)
-		{
-			if (!FSimplePropertyTransactionManager::Get().CancelManagedTransaction(TransactionId))
-			{
-				bModifiedInTransaction = false;
-				TransactionId = FSimplePropertyTransactionManager::GetInvalidTransactionId();
-				return ESimplePropertyTransactionEndResult::UnknownError;
-			}
-		}
-		else
-		{
-			if (!FSimplePropertyTransactionManager::Get().EndManagedTransaction(TransactionId))
-			{
-				bModifiedInTransaction = false;
-				TransactionId = FSimplePropertyTransactionManager::GetInvalidTransactionId();
-				return ESimplePropertyTransactionEndResult::UnknownError;
-			}
-		}
-
-		bModifiedInTransaction = false;
-		TransactionId = FSimplePropertyTransactionManager::GetInvalidTransactionId();
-		return ESimplePropertyTransactionEndResult::Ended;
+		return TransactionState.EndManagedTransaction(bInCancelIfUnmodified);
 	}
 
 	ESimplePropertyTransactionEndResult CancelUnmanagedTransaction()
 	{
-		bModifiedInTransaction = false;
-
-		if (!FSimplePropertyTransactionManager::IsValidTransactionId(TransactionId))
-		{
-			TransactionId = FSimplePropertyTransactionManager::GetInvalidTransactionId();
-			return ESimplePropertyTransactionEndResult::Invalid;
-		}
-
-		if (!ensure(FSimplePropertyTransactionManager::Get().IsUnmanagedTransaction(TransactionId)))
-		{
-			TransactionId = FSimplePropertyTransactionManager::GetInvalidTransactionId();
-			return ESimplePropertyTransactionEndResult::NotUnmanaged;
-		}
-
-		if (!FSimplePropertyTransactionManager::Get().CancelUnmanagedTransaction(TransactionId))
-		{
-			TransactionId = FSimplePropertyTransactionManager::GetInvalidTransactionId();
-			return ESimplePropertyTransactionEndResult::UnknownError;
-		}
-
-		TransactionId = FSimplePropertyTransactionManager::GetInvalidTransactionId();
-		return ESimplePropertyTransactionEndResult::Cancelled;
+		return TransactionState.CancelUnmanagedTransaction();
 	}
 
 	ESimplePropertyTransactionEndResult EndUnmanagedTransaction(bool bInCancelIfUnmodified = false)
 	{
-		if (!FSimplePropertyTransactionManager::IsValidTransactionId(TransactionId))
-		{
-			bModifiedInTransaction = false;
-			TransactionId = FSimplePropertyTransactionManager::GetInvalidTransactionId();
-			return ESimplePropertyTransactionEndResult::Invalid;
-		}
-
-		if (!ensure(FSimplePropertyTransactionManager::Get().IsUnmanagedTransaction(TransactionId)))
-		{
-			bModifiedInTransaction = false;
-			TransactionId = FSimplePropertyTransactionManager::GetInvalidTransactionId();
-			return ESimplePropertyTransactionEndResult::NotUnmanaged;
-		}
-
-		if (bInCancelIfUnmodified && !bModifiedInTransaction)
-		{
-			if (!FSimplePropertyTransactionManager::Get().CancelUnmanagedTransaction(TransactionId))
-			{
-				bModifiedInTransaction = false;
-				TransactionId = FSimplePropertyTransactionManager::GetInvalidTransactionId();
-				return ESimplePropertyTransactionEndResult::UnknownError;
-			}
-		}
-		else
-		{
-			if (FSimplePropertyTransactionManager::Get().EndUnmanagedTransaction(TransactionId))
-			{
-				bModifiedInTransaction = false;
-				TransactionId = FSimplePropertyTransactionManager::GetInvalidTransactionId();
-				return ESimplePropertyTransactionEndResult::Ended;
-			}
-		}
-
-		bModifiedInTransaction = false;
-		TransactionId = FSimplePropertyTransactionManager::GetInvalidTransactionId();
-		return ESimplePropertyTransactionEndResult::UnknownError;
+		return TransactionState.EndUnmanagedTransaction(bInCancelIfUnmodified);
 	}
 
 	bool HasManagedTransaction() const
 	{
-		return FSimplePropertyTransactionManager::Get().IsManagedTransaction(TransactionId);
+		return TransactionState.HasManagedTransaction();
 	}
 
 	bool HasUnmangaedTransaction() const
 	{
-		return FSimplePropertyTransactionManager::IsUnmanagedTransaction(TransactionId);
+		return TransactionState.HasUnmanagedTransaction();
 	}
 
 	/** Returns true if we have a an active transaction and we've been modified. */
 	bool IsModified() const
 	{
-		return bModifiedInTransaction;
+		return TransactionState.IsModified();
 	}
 #endif
 
 protected:
-	FSimplePropertyOnChange::FDelegate OnChangeDelegate;
+	friend struct FSimplePropertyAccess;
+
+	friend class FSimplePropertyHooks;
+
+#if SIMPLE_PROPERTIES_WITH_COROUTINES
+	friend class FSimplePropertyAwait;
+#endif
+
+	FOnCallback OnChangeDelegate;
 
 #if WITH_EDITOR
-	int32 TransactionId = FSimplePropertyTransactionManager::GetInvalidTransactionId();
-	uint8 bHasOnChange : 1 = false;
-	uint8 bModifiedInTransaction : 1 = false;
+	FSimplePropertyTransactionState TransactionState;
+
+	// The value-type dependent parts of the transaction support.
+	UObject* GetTransactionObject() const
+	{
+		return FTransactionObjectType::GetTransactionObject(Base::Value);
+	}
+
+	static const void* GetUndoValue(const void* InProperty)
+	{
+		return &static_cast<const TSimpleConstProperty*>(InProperty)->Value;
+	}
+
+	static void SetUndoValue(void* InProperty, const void* InValue)
+	{
+		static_cast<TSimpleConstProperty*>(InProperty)->SetInternal(*static_cast<const FValueType*>(InValue));
+	}
+
+	static void CopyUndoValue(void* InDestination, const void* InSource)
+	{
+		new (InDestination) FValueType(*static_cast<const FValueType*>(InSource));
+	}
+
+	static void DestroyUndoValue(void* InValue)
+	{
+		static_cast<FValueType*>(InValue)->~FValueType();
+	}
+
+	static constexpr FSimplePropertyUndoValueOps UndoValueOps = {
+		sizeof(FValueType), alignof(FValueType), &GetUndoValue, &SetUndoValue, &CopyUndoValue, &DestroyUndoValue
+	};
+
+	// Before the value is replaced, in case a transaction with an undo owner is active.
+	void RecordUndo()
+	{
+		if (TransactionState.ShouldRecordUndo())
+		{
+			TransactionState.RecordUndo(this, UndoValueOps);
+		}
+	}
 #endif
 
+	uint8 bHasOnChange : 1 = false;
+
+	// Set once a set or notification of this property has been deferred (FSimplePropertyPropagation). Not copied or moved.
+	uint8 bHasDeferred : 1 = false;
+
+	// Set while a hook is attached (FSimplePropertyHooks), HookSlot is then its slot. Not copied or moved.
+	uint8 bHasHooks : 1 = false;
+	int32 HookSlot = INDEX_NONE;
+
 	template<typename InCompareType>
 	bool IsEqual(const InCompareType& InOther)
 	{
@@ -528,13 +439,37 @@ protected:
 				return false;
 			}
 
+			// Our callback is already running further up the stack, apply this once the current change wave is done.
+			if (!FSimplePropertyPropagation::Enter(this, OnChangeDelegate))
+			{
+				bHasDeferred = true;
+				FSimplePropertyPropagation::Defer(this, OnChangeDelegate,
+					[this, DeferredValue = FValueType(InValue)]() mutable
+					{
+						SetInternal(MoveTemp(DeferredValue));
+					});
+
+				// Not changed yet, and a later set or a storm may replace it.
+				return false;
+			}
+
+#if WITH_EDITOR
+			RecordUndo();
+#endif
+
 			Base::Value = InValue;
 			
 			constexpr ESimplePropertyChangeEventType CallEvent = ESimplePropertyChangeEventType::Execute;
 			OnChange(CallEvent);
+
+			FSimplePropertyPropagation::Exit();
 		}
 		else
 		{
+#if WITH_EDITOR
+			RecordUndo();
+#endif
+
 			Base::Value = InValue;
 			
 			constexpr ESimplePropertyChangeEventType CallEvent = ESimplePropertyChangeEventType::Skip;
@@ -555,14 +490,38 @@ protected:
 				return false;
 			}
 
-			Base::Value = MoveTemp(InValue);
+			// Our callback is already running further up the stack, apply this once the current change wave is done.
+			if (!FSimplePropertyPropagation::Enter(this, OnChangeDelegate))
+			{
+				bHasDeferred = true;
+				FSimplePropertyPropagation::Defer(this, OnChangeDelegate,
+					[this, DeferredValue = FValueType(Forward<InAssignType>(InValue))]() mutable
+					{
+						SetInternal(MoveTemp(DeferredValue));
+					});
+
+				// Not changed yet, and a later set or a storm may replace it.
+				return false;
+			}
+
+#if WITH_EDITOR
+			RecordUndo();
+#endif
+
+			Base::Value = Forward<InAssignType>(InValue);
 
 			constexpr ESimplePropertyChangeEventType CallEvent = ESimplePropertyChangeEventType::Execute;
 			OnChange(CallEvent);
+
+			FSimplePropertyPropagation::Exit();
 		}
 		else
 		{
-			Base::Value = MoveTemp(InValue);
+#if WITH_EDITOR
+			RecordUndo();
+#endif
+
+			Base::Value = Forward<InAssignType>(InValue);
 
 			constexpr ESimplePropertyChangeEventType CallEvent = ESimplePropertyChangeEventType::Skip;
 			OnChange(CallEvent);
@@ -573,13 +532,7 @@ protected:
 };
 
 // Can be get and set by anything
-template<typename InValueType, 
-	typename InPrivateType = UE::SimpleProperties::NoType
-	UE_REQUIRES(TOr<TOr<
-			TModels<CEqualityComparable, InValueType>, 
-			TModels<CEqualityEquals, InValueType>>, 
-			TModels<CEqualityEqualTo, InValueType>>
-		::Value)>
+template<typename InValueType, typename InPrivateType>
 struct TSimpleProperty : public TSimpleConstProperty<InValueType, InPrivateType>
 {
 	using Super = TSimpleConstProperty<InValueType, InPrivateType>;
@@ -600,40 +553,40 @@ struct TSimpleProperty : public TSimpleConstProperty<InValueType, InPrivateType>
 	}
 
 	TSimpleProperty(TSimpleProperty&& InOther)
-		: Super(Forward<FValueType>(InOther.Value), Forward<Super::FOnCallback>(InOther.OnChangeDelegate))
+		: Super(Forward<FValueType>(InOther.Value), Forward<typename Super::FOnCallback>(InOther.OnChangeDelegate))
 	{
 	}
 
 	TSimpleProperty(FSimplePropertyOnChange&& InUpdateFunc)
-		: Super(Forward<Super::FOnCallback>(InUpdateFunc.Callback))
+		: Super(MoveTemp(InUpdateFunc))
 	{
 	}
 
 	template<typename InAssignType
 		UE_REQUIRES(std::negation_v<std::is_same<InAssignType, FSimplePropertyOnChange>>)>
 	TSimpleProperty(const InAssignType& InDefaultValue)
-		: Super(InDefaultValue, FSimplePropertyOnChange::FDelegate())
+		: Super(InDefaultValue, typename Super::FOnCallback())
 	{
 	}
 
 	template<typename InAssignType
 		UE_REQUIRES(std::negation_v<std::is_same<InAssignType, FSimplePropertyOnChange>>)>
 	TSimpleProperty(InAssignType&& InDefaultValue)
-		: Super(Forward<InAssignType>(InDefaultValue), FSimplePropertyOnChange::FDelegate())
+		: Super(Forward<InAssignType>(InDefaultValue), typename Super::FOnCallback())
 	{
 	}
 
 	template<typename InAssignType
 		UE_REQUIRES(std::negation_v<std::is_same<InAssignType, FSimplePropertyOnChange>>)>
 	TSimpleProperty(const InAssignType& InDefaultValue, FSimplePropertyOnChange&& InUpdateFunc)
-		: Super(InDefaultValue, Forward<FSimplePropertyOnChange::FDelegate>(InUpdateFunc.Callback))
+		: Super(InDefaultValue, MoveTemp(InUpdateFunc))
 	{
 	}
 
 	template<typename InAssignType
 		UE_REQUIRES(std::negation_v<std::is_same<InAssignType, FSimplePropertyOnChange>>)>
 	TSimpleProperty(InAssignType&& InDefaultValue, FSimplePropertyOnChange&& InUpdateFunc)
-		: Super(Forward<InAssignType>(InDefaultValue), Forward<FSimplePropertyOnChange::FDelegate>(InUpdateFunc.Callback))
+		: Super(Forward<InAssignType>(InDefaultValue), MoveTemp(InUpdateFunc))
 	{
 	}
 
@@ -646,7 +599,7 @@ struct TSimpleProperty : public TSimpleConstProperty<InValueType, InPrivateType>
 	template<typename InAssignType>
 	bool operator=(InAssignType&& InValue)
 	{
-		return Super::SetInternal(MoveTemp(InValue));
+		return Super::SetInternal(Forward<InAssignType>(InValue));
 	}
 
 	template<typename InAssignType>
@@ -677,15 +630,10 @@ struct TSimpleProperty : public TSimpleConstProperty<InValueType, InPrivateType>
 	}
 };
 
-template<typename InValueType>
-struct TStructOpsTypeTraits<TSimplePropertyBase<InValueType>>
-	: public TStructOpsTypeTraitsBase2<TSimplePropertyBase<InValueType>>
-{
-	enum
-	{
-		WithCopy = true,
-		WithIdenticalViaEquality = true,
-		WithAddStructReferencedObjects = TSimplePropertyTypeTraits<InValueType>::FReferenceCollectorType::Value,
-		WithFindInnerPropertyInstance = TSimplePropertyTypeTraits<InValueType>::FFindInnerPropertyType::Value
-	};
-};
+// Common value types are instantiated once in SimpleProperty.cpp instead of in every translation unit that uses them.
+extern template struct SIMPLEPROPERTIES_API TSimpleConstProperty<bool>;
+extern template struct SIMPLEPROPERTIES_API TSimpleConstProperty<uint8>;
+extern template struct SIMPLEPROPERTIES_API TSimpleConstProperty<int32>;
+extern template struct SIMPLEPROPERTIES_API TSimpleConstProperty<int64>;
+extern template struct SIMPLEPROPERTIES_API TSimpleConstProperty<float>;
+extern template struct SIMPLEPROPERTIES_API TSimpleConstProperty<double>;
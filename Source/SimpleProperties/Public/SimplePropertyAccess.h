@@ -0,0 +1,153 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "SimpleProperty.h"
+#include "Templates/UnrealTemplate.h"
+#include <type_traits>
+
+/**
+ * Raw access to property internals for the plugin's batch systems (snapshots, history, bulk updates).
+ * Bypasses change events, so gameplay code should use the property API instead.
+ */
+struct FSimplePropertyAccess
+{
+	template<typename InValueType>
+	static typename TSimplePropertyBase<InValueType>::FValueType& GetValue(TSimplePropertyBase<InValueType>& InProperty)
+	{
+		return InProperty.Value;
+	}
+
+	template<typename InValueType>
+	static const typename TSimplePropertyBase<InValueType>::FValueType& GetValue(const TSimplePropertyBase<InValueType>& InProperty)
+	{
+		return InProperty.Value;
+	}
+
+	/** Stores the value without firing the change event. Returns true if it was different. */
+	template<typename InValueType, typename InPrivateType, typename InAssignType>
+	static bool SetValueSilently(TSimpleConstProperty<InValueType, InPrivateType>& InProperty, InAssignType&& InValue)
+	{
+		if (InProperty.IsEqual(InValue))
+		{
+			return false;
+		}
+
+		InProperty.Value = Forward<InAssignType>(InValue);
+		return true;
+	}
+
+	/**
+	 * Fires the change event for a value that was stored with SetValueSilently. Goes through the same re-entrancy
+	 * guard as a set: if the property's callback is already running further up the stack, the notification is
+	 * deferred until the change wave is done.
+	 */
+	template<typename InValueType, typename InPrivateType>
+	static void NotifyChanged(TSimpleConstProperty<InValueType, InPrivateType>& InProperty)
+	{
+		if (!InProperty.bHasOnChange)
+		{
+			InProperty.OnChange(ESimplePropertyChangeEventType::Skip);
+			return;
+		}
+
+		if (!FSimplePropertyPropagation::Enter(&InProperty, InProperty.OnChangeDelegate))
+		{
+			InProperty.bHasDeferred = true;
+			FSimplePropertyPropagation::Defer(&InProperty, InProperty.OnChangeDelegate, [&InProperty]()
+				{
+					NotifyChanged(InProperty);
+				});
+
+			return;
+		}
+
+		InProperty.OnChange(ESimplePropertyChangeEventType::Execute);
+
+		FSimplePropertyPropagation::Exit();
+	}
+
+	/** Fires only the change callback, guarded like NotifyChanged. For batches that dispatch the hooks themselves. */
+	template<typename InValueType, typename InPrivateType>
+	static void NotifyCallback(TSimpleConstProperty<InValueType, InPrivateType>& InProperty)
+	{
+		if (!InProperty.bHasOnChange)
+		{
+			return;
+		}
+
+		if (!FSimplePropertyPropagation::Enter(&InProperty, InProperty.OnChangeDelegate))
+		{
+			InProperty.bHasDeferred = true;
+			FSimplePropertyPropagation::Defer(&InProperty, InProperty.OnChangeDelegate, [&InProperty]()
+				{
+					NotifyCallback(InProperty);
+				});
+
+			return;
+		}
+
+		InProperty.OnChangeDelegate.Execute();
+
+		FSimplePropertyPropagation::Exit();
+	}
+
+	/** Runs the mirror, journal, push model, buffering and awaiting hooks without the change callback. */
+	template<typename InValueType, typename InPrivateType>
+	static void NotifyHooks(TSimpleConstProperty<InValueType, InPrivateType>& InProperty)
+	{
+		InProperty.OnChange(ESimplePropertyChangeEventType::Skip);
+	}
+
+	template<typename InValueType, typename InPrivateType>
+	static bool HasHooks(const TSimpleConstProperty<InValueType, InPrivateType>& InProperty)
+	{
+		return InProperty.bHasHooks;
+	}
+
+#if WITH_EDITOR
+	/** How FSimplePropertyUndo copies and restores the property's value. */
+	template<typename InValueType, typename InPrivateType>
+	static const FSimplePropertyUndoValueOps& GetUndoValueOps(const TSimpleConstProperty<InValueType, InPrivateType>& InProperty)
+	{
+		return TSimpleConstProperty<InValueType, InPrivateType>::UndoValueOps;
+	}
+#endif
+
+	/**
+	 * Whether NotifyChanged may run on a worker alongside other notifications: the callback is unbound or marked
+	 * thread-safe, and no game-thread-only hook (push model, buffering, awaiting) is attached.
+	 */
+	template<typename InValueType, typename InPrivateType>
+	static bool CanNotifyConcurrently(const TSimpleConstProperty<InValueType, InPrivateType>& InProperty)
+	{
+		if (InProperty.bHasOnChange && !InProperty.OnChangeDelegate.IsThreadSafe())
+		{
+			return false;
+		}
+
+		return !FSimplePropertyHooks::HasHook(InProperty,
+			ESimplePropertyHook::PushModel | ESimplePropertyHook::Buffered | ESimplePropertyHook::Await);
+	}
+
+	/**
+	 * Byte offset of the value within a property. Properties derive singly and without virtuals from
+	 * TSimplePropertyBase, so the base, and its value, start the property.
+	 */
+	template<typename InPropertyType>
+	static int32 GetValueOffsetInProperty()
+	{
+		using FBaseType = typename InPropertyType::Base;
+
+		static_assert(std::is_base_of_v<FBaseType, InPropertyType> && !std::is_polymorphic_v<InPropertyType>);
+
+		return static_cast<int32>(STRUCT_OFFSET(FBaseType, Value));
+	}
+
+	/** Byte offset of a property's value within its owner, given the property's offset (STRUCT_OFFSET(Owner, Member)). */
+	template<typename InPropertyType>
+	static int32 GetValueOffset(SIZE_T InPropertyOffset)
+	{
+		return static_cast<int32>(InPropertyOffset) + GetValueOffsetInProperty<InPropertyType>();
+	}
+};
@@ -0,0 +1,144 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "Serialization/Archive.h"
+#include "SimpleProperty.h"
+#include "SimplePropertyAccess.h"
+#include "SimplePropertyContainers.h"
+#include "SimplePropertyFlags.h"
+#include "SimplePropertySparse.h"
+
+// Per-property serialization. To load or save every property of an owner in one go, with the trivially copyable
+// values as a single block and versioning, use FSimplePropertyLayout::Serialize.
+
+// Loads silently, the base has no change event.
+template<typename InValueType>
+FArchive& operator<<(FArchive& InArchive, TSimplePropertyBase<InValueType>& InProperty)
+{
+	InArchive << InProperty.Value;
+	return InArchive;
+}
+
+// Loading fires the change event if the loaded value is different.
+template<typename InValueType, typename InPrivateType>
+FArchive& operator<<(FArchive& InArchive, TSimpleConstProperty<InValueType, InPrivateType>& InProperty)
+{
+	using FValueType = typename TSimpleConstProperty<InValueType, InPrivateType>::FValueType;
+
+	if (!InArchive.IsLoading())
+	{
+		InArchive << FSimplePropertyAccess::GetValue(InProperty);
+		return InArchive;
+	}
+
+	FValueType NewValue;
+	InArchive << NewValue;
+
+	if (FSimplePropertyAccess::SetValueSilently(InProperty, MoveTemp(NewValue)))
+	{
+		FSimplePropertyAccess::NotifyChanged(InProperty);
+	}
+
+	return InArchive;
+}
+
+// Only the value is saved. Loading the default value frees the override.
+template<typename InValueType>
+FArchive& operator<<(FArchive& InArchive, TSimpleSparseProperty<InValueType>& InProperty)
+{
+	if (!InArchive.IsLoading())
+	{
+		InArchive << const_cast<InValueType&>(InProperty.Get());
+		return InArchive;
+	}
+
+	InValueType NewValue;
+	InArchive << NewValue;
+	InProperty.Set(MoveTemp(NewValue));
+	return InArchive;
+}
+
+template<typename InFlagType, typename InStorageType>
+FArchive& operator<<(FArchive& InArchive, TSimpleFlagsProperty<InFlagType, InStorageType>& InProperty)
+{
+	InStorageType Value = InProperty.GetAll();
+	InArchive << Value;
+
+	if (InArchive.IsLoading())
+	{
+		InProperty.SetAll(Value);
+	}
+
+	return InArchive;
+}
+
+// Container loads replace the contents through the property API, so listeners see a Reset followed by the Adds.
+template<typename InElementType, typename InAllocatorType>
+FArchive& operator<<(FArchive& InArchive, TSimpleArrayProperty<InElementType, InAllocatorType>& InProperty)
+{
+	using FArrayType = typename TSimpleArrayProperty<InElementType, InAllocatorType>::FArrayType;
+
+	if (!InArchive.IsLoading())
+	{
+		InArchive << const_cast<FArrayType&>(*InProperty);
+		return InArchive;
+	}
+
+	FArrayType NewValue;
+	InArchive << NewValue;
+	InProperty.Reset();
+
+	for (InElementType& Element : NewValue)
+	{
+		InProperty.Add(MoveTemp(Element));
+	}
+
+	return InArchive;
+}
+
+template<typename InKeyType, typename InValueType>
+FArchive& operator<<(FArchive& InArchive, TSimpleMapProperty<InKeyType, InValueType>& InProperty)
+{
+	using FMapType = typename TSimpleMapProperty<InKeyType, InValueType>::FMapType;
+
+	if (!InArchive.IsLoading())
+	{
+		InArchive << const_cast<FMapType&>(*InProperty);
+		return InArchive;
+	}
+
+	FMapType NewValue;
+	InArchive << NewValue;
+	InProperty.Reset();
+
+	for (TPair<InKeyType, InValueType>& Pair : NewValue)
+	{
+		InProperty.Add(Pair.Key, MoveTemp(Pair.Value));
+	}
+
+	return InArchive;
+}
+
+template<typename InElementType>
+FArchive& operator<<(FArchive& InArchive, TSimpleSetProperty<InElementType>& InProperty)
+{
+	using FSetType = typename TSimpleSetProperty<InElementType>::FSetType;
+
+	if (!InArchive.IsLoading())
+	{
+		InArchive << const_cast<FSetType&>(*InProperty);
+		return InArchive;
+	}
+
+	FSetType NewValue;
+	InArchive << NewValue;
+	InProperty.Reset();
+
+	for (const InElementType& Element : NewValue)
+	{
+		InProperty.Add(Element);
+	}
+
+	return InArchive;
+}
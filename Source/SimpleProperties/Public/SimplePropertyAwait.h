@@ -0,0 +1,182 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "SimplePropertiesFwd.h"
+
+#if SIMPLE_PROPERTIES_WITH_COROUTINES
+
+#include "SimplePropertyHooks.h"
+#include "Templates/UnrealTemplate.h"
+#include <coroutine>
+
+/** A coroutine waiting on a property. Lives in the awaiter, in the suspended coroutine's frame. */
+struct FSimplePropertyAwaitNode
+{
+	// The property's hook slot, which holds its waiting list.
+	int32 HookSlot = INDEX_NONE;
+
+	FSimplePropertyAwaitNode* Prev = nullptr;
+	FSimplePropertyAwaitNode* Next = nullptr;
+
+	// Set while the node is in a list being resumed, rather than in the waiting list.
+	FSimplePropertyAwaitResume* Resuming = nullptr;
+
+	std::coroutine_handle<> Handle;
+
+	// Checked on each change before resuming. Null resumes on any change.
+	bool (*IsReady)(const FSimplePropertyAwaitNode* InNode) = nullptr;
+
+	bool bLinked = false;
+	bool bCancelled = false;
+};
+
+/**
+ * A change's waiters while they're being resumed. On the stack of the resume, and linked from the property's hook
+ * slot so that destroying the property part way through cancels the waiters that haven't been resumed yet.
+ */
+struct FSimplePropertyAwaitResume
+{
+	FSimplePropertyAwaitNode* Head = nullptr;
+
+	// The resume this one is nested in, when a resumed coroutine changed the property again.
+	FSimplePropertyAwaitResume* Outer = nullptr;
+
+	bool bPropertyDestroyed = false;
+};
+
+/**
+ * Waiting lists for coroutines suspended on a property's changes (Property.NextChange(), Property.Until()).
+ *
+ * The awaiter is the list node and lives in the suspended coroutine's frame, and the list's head is kept in the
+ * property's hook slot, so waiting doesn't allocate. Waiters are resumed from the property's change path, after its
+ * change callback and its other hooks. A coroutine that awaits again while being resumed waits for the next change,
+ * not the current one. The hook is detached once no coroutine is waiting.
+ *
+ * Destroying the property resumes its waiters with a cancelled result, including the ones still to be resumed for a
+ * change that's being handled when it's destroyed. Nothing touches the property or its slot after that.
+ *
+ * Game thread only.
+ */
+class SIMPLEPROPERTIES_API FSimplePropertyAwait
+{
+public:
+	using FNode = FSimplePropertyAwaitNode;
+
+	/** Called by the property's hooks when its value changes. */
+	static void Resume(int32 InHookSlot);
+
+	/** Called by the property's hooks when it's destroyed. */
+	static void Cancel(int32 InHookSlot);
+
+	template<typename InPropertyType>
+	static void Wait(InPropertyType& InProperty, FNode& InNode, std::coroutine_handle<> InHandle)
+	{
+		FSimplePropertyHooks::Attach(InProperty, ESimplePropertyHook::Await);
+		InNode.HookSlot = InProperty.HookSlot;
+		InNode.Handle = InHandle;
+		Link(InNode);
+	}
+
+	template<typename InPropertyType>
+	static const auto& GetValue(const InPropertyType& InProperty)
+	{
+		return InProperty.Value;
+	}
+
+	static void Unlink(FNode& InNode);
+
+protected:
+	static void Link(FNode& InNode);
+
+	/** Resumes or cancels the context's nodes. Only touches them, a resumed coroutine may destroy the property. */
+	static void ResumeAll(FSimplePropertyAwaitResume& InContext);
+};
+
+/** Awaiter for Property.NextChange(). Resumes with true on the next change, false if the property was destroyed. */
+template<typename InPropertyType>
+class TSimplePropertyChangeAwaiter : protected FSimplePropertyAwaitNode
+{
+public:
+	explicit TSimplePropertyChangeAwaiter(InPropertyType& InProperty)
+		: Property(InProperty)
+	{
+	}
+
+	TSimplePropertyChangeAwaiter(const TSimplePropertyChangeAwaiter&) = delete;
+	TSimplePropertyChangeAwaiter& operator=(const TSimplePropertyChangeAwaiter&) = delete;
+
+	// The coroutine was destroyed while waiting.
+	~TSimplePropertyChangeAwaiter()
+	{
+		FSimplePropertyAwait::Unlink(*this);
+	}
+
+	bool await_ready() const
+	{
+		return false;
+	}
+
+	void await_suspend(std::coroutine_handle<> InHandle)
+	{
+		FSimplePropertyAwait::Wait(Property, *this, InHandle);
+	}
+
+	bool await_resume() const
+	{
+		return !bCancelled;
+	}
+
+protected:
+	InPropertyType& Property;
+};
+
+/**
+ * Awaiter for Property.Until(Predicate). Doesn't suspend if the predicate already holds, otherwise checks it after
+ * each change. Resumes with true once it holds, false if the property was destroyed.
+ */
+template<typename InPropertyType, typename InPredicateType>
+class TSimplePropertyUntilAwaiter : protected FSimplePropertyAwaitNode
+{
+public:
+	TSimplePropertyUntilAwaiter(InPropertyType& InProperty, InPredicateType&& InPredicate)
+		: Property(InProperty)
+		, Predicate(MoveTemp(InPredicate))
+	{
+		IsReady = &IsPredicateTrue;
+	}
+
+	TSimplePropertyUntilAwaiter(const TSimplePropertyUntilAwaiter&) = delete;
+	TSimplePropertyUntilAwaiter& operator=(const TSimplePropertyUntilAwaiter&) = delete;
+
+	~TSimplePropertyUntilAwaiter()
+	{
+		FSimplePropertyAwait::Unlink(*this);
+	}
+
+	bool await_ready() const
+	{
+		return Predicate(FSimplePropertyAwait::GetValue(Property));
+	}
+
+	void await_suspend(std::coroutine_handle<> InHandle)
+	{
+		FSimplePropertyAwait::Wait(Property, *this, InHandle);
+	}
+
+	bool await_resume() const
+	{
+		return !bCancelled;
+	}
+
+protected:
+	InPropertyType& Property;
+	InPredicateType Predicate;
+
+	static bool IsPredicateTrue(const FSimplePropertyAwaitNode* InNode)
+	{
+		return static_cast<const TSimplePropertyUntilAwaiter*>(InNode)->await_ready();
+	}
+};
+
+#endif
@@ -0,0 +1,173 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "Misc/ScopeExit.h"
+#include "SimpleProperty.h"
+#include "Templates/Invoke.h"
+#include "Templates/UnrealTemplate.h"
+#include <atomic>
+
+/**
+ * Publishes the values of buffered properties (TSimpleBufferedProperty) that changed this frame. Runs at the end of
+ * every frame on the game thread; only properties that were set since the last publish are copied.
+ */
+class SIMPLEPROPERTIES_API FSimplePropertyBuffers
+{
+public:
+	// Returns false if every buffer it could publish into was being read, to be retried on the next publish.
+	using FPublishFunction = bool(*)(void* InProperty);
+
+	/** Called by buffered properties when their value changes, with the index returned by registration. */
+	static void MarkDirty(int32 InBufferIndex);
+
+	/** Publishes every changed property. Called at the end of the frame, call it directly for an early publish. */
+	static void Publish();
+
+	/** Called by the module. */
+	static void Initialize();
+	static void Shutdown();
+
+protected:
+	friend class FSimplePropertyHooks;
+
+	template<typename, typename>
+	friend struct TSimpleBufferedProperty;
+
+	static int32 RegisterInternal(void* InProperty, FPublishFunction InPublish);
+	static void UnregisterInternal(int32 InBufferIndex);
+};
+
+/**
+ * A property whose value can be read from any thread without locks. The game thread sets it as usual; other
+ * threads (render proxies, tasks) read the value as of the last publish. Publishing copies the value into one of
+ * three buffers that is neither the current one nor being read, then makes it current, so a reader never sees a
+ * buffer being written however long it takes. If both other buffers are still being read, the publish is retried on
+ * the next one.
+ *
+ * Readers count themselves in on the buffer they read, so keep reads short: Read copies the value, ReadWith hands a
+ * reference to a function and the reference must not outlive the call.
+ *
+ * The property is registered by address. It must not be moved in memory (e.g. by a TArray growing), which is checked
+ * when it's set and when it's published. Store it in a fixed location, or allocate it.
+ *
+ * Game thread sets only.
+ */
+template<typename InValueType, typename InPrivateType = UE::SimpleProperties::NoType>
+struct TSimpleBufferedProperty : public TSimpleProperty<InValueType, InPrivateType>
+{
+	using Super = TSimpleProperty<InValueType, InPrivateType>;
+	using FValueType = typename Super::FValueType;
+
+	using Super::Super;
+	using Super::operator=;
+
+	TSimpleBufferedProperty() = default;
+
+	TSimpleBufferedProperty(const TSimpleBufferedProperty& InOther)
+		: Super(InOther)
+	{
+	}
+
+	TSimpleBufferedProperty(TSimpleBufferedProperty&& InOther)
+		: Super(MoveTemp(InOther))
+	{
+	}
+
+	~TSimpleBufferedProperty()
+	{
+		Unregister();
+	}
+
+	bool operator=(const TSimpleBufferedProperty& InOther)
+	{
+		return Super::SetInternal(InOther.Value);
+	}
+
+	/** Any thread. A copy of the value as of the last publish. */
+	FValueType Read() const
+	{
+		return ReadWith([](const FValueType& InValue) { return InValue; });
+	}
+
+	/** Any thread. Calls InFunction with the value as of the last publish, which is kept from being overwritten until it returns. */
+	template<typename InFunctionType>
+	auto ReadWith(InFunctionType&& InFunction) const
+	{
+		const uint8 BufferIndex = AcquireRead();
+
+		ON_SCOPE_EXIT
+		{
+			Readers[BufferIndex].fetch_sub(1, std::memory_order_release);
+		};
+
+		return Invoke(Forward<InFunctionType>(InFunction), static_cast<const FValueType&>(Buffers[BufferIndex]));
+	}
+
+protected:
+	static constexpr uint8 NumBuffers = 3;
+
+	FValueType Buffers[NumBuffers] = {this->Value, this->Value, this->Value};
+	std::atomic<uint8> ReadIndex = 0;
+	mutable std::atomic<int32> Readers[NumBuffers] = {0, 0, 0};
+
+	// Declared last so it runs after the members above are initialized, for the inherited constructors too.
+	bool bRegistered = Register();
+
+	bool Register()
+	{
+		const int32 BufferIndex = FSimplePropertyBuffers::RegisterInternal(this, &PublishBuffer);
+		FSimplePropertyHooks::Attach(*this, ESimplePropertyHook::Buffered).BufferIndex = BufferIndex;
+		return true;
+	}
+
+	void Unregister()
+	{
+		if (FSimplePropertyHooks::HasHook(*this, ESimplePropertyHook::Buffered))
+		{
+			FSimplePropertyBuffers::UnregisterInternal(FSimplePropertyHooks::GetSlot(*this).BufferIndex);
+			FSimplePropertyHooks::Detach(*this, ESimplePropertyHook::Buffered);
+		}
+	}
+
+	// The current buffer, counted in. The count is checked against the current index again, so a buffer that was
+	// flipped away from in between (and may be written by the next publish) is never read.
+	uint8 AcquireRead() const
+	{
+		for (;;)
+		{
+			const uint8 BufferIndex = ReadIndex.load(std::memory_order_seq_cst);
+			Readers[BufferIndex].fetch_add(1, std::memory_order_seq_cst);
+
+			if (ReadIndex.load(std::memory_order_seq_cst) == BufferIndex)
+			{
+				return BufferIndex;
+			}
+
+			Readers[BufferIndex].fetch_sub(1, std::memory_order_relaxed);
+		}
+	}
+
+	static bool PublishBuffer(void* InProperty)
+	{
+		TSimpleBufferedProperty& Property = *static_cast<TSimpleBufferedProperty*>(InProperty);
+
+		checkf(FSimplePropertyHooks::GetSlot(Property).Property == &Property,
+			TEXT("A buffered property was moved in memory."));
+
+		const uint8 CurrentIndex = Property.ReadIndex.load(std::memory_order_relaxed);
+
+		for (uint8 BufferIndex = 0; BufferIndex < NumBuffers; ++BufferIndex)
+		{
+			// Readers that count themselves in after this see the buffer isn't current and back off.
+			if (BufferIndex != CurrentIndex && Property.Readers[BufferIndex].load(std::memory_order_seq_cst) == 0)
+			{
+				Property.Buffers[BufferIndex] = Property.Value;
+				Property.ReadIndex.store(BufferIndex, std::memory_order_seq_cst);
+				return true;
+			}
+		}
+
+		return false;
+	}
+};
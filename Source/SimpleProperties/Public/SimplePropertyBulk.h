@@ -0,0 +1,142 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "Async/ParallelFor.h"
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "SimplePropertyAccess.h"
+#include "Templates/Identity.h"
+#include "Templates/UnrealTemplate.h"
+
+enum class ESimplePropertyBulkDispatch : uint8
+{
+	// Callbacks run on the calling thread, in owner order. Use this unless you know the callbacks are thread-safe.
+	Serial,
+	// Callbacks marked thread-safe (MarkThreadSafe) run from ParallelFor in no particular order. The others run on
+	// the calling thread afterwards, in owner order.
+	Parallel
+};
+
+/**
+ * Updates the same property on many owners at once, e.g. a damage-over-time tick.
+ *
+ * The store-and-compare phase runs with ParallelFor and doesn't fire anything. The owners that actually changed are
+ * collected and their callbacks are then dispatched as a second phase, so callbacks never observe a half-updated range.
+ * The dispatch goes through the same re-entrancy guard as single sets, so a callback that sets a property whose
+ * callback is already running is deferred the same way.
+ *
+ * Each owner must appear in the range at most once. Whether a callback may run on a worker is decided per callback,
+ * not per call: see ESimplePropertyBulkDispatch::Parallel.
+ *
+ * The owner range doesn't take part in template deduction, so a TArray<AMyActor*> can be passed directly.
+ */
+struct FSimplePropertyBulk
+{
+	static constexpr int32 DefaultMinBatchSize = 512;
+
+	/** Sets every owner's property to InValue. Returns the number of properties that changed. */
+	template<typename InOwnerType, typename InValueType, typename InPrivateType, typename InAssignType>
+	static int32 Set(TArrayView<TIdentity_T<InOwnerType>* const> InOwners, TSimpleProperty<InValueType, InPrivateType> InOwnerType::* InMember,
+		const InAssignType& InValue, ESimplePropertyBulkDispatch InDispatch = ESimplePropertyBulkDispatch::Serial,
+		int32 InMinBatchSize = DefaultMinBatchSize)
+	{
+		return Update(InOwners, InMember,
+			[&InValue](const InOwnerType&, const InValueType&) -> const InAssignType&
+			{
+				return InValue;
+			},
+			InDispatch, InMinBatchSize);
+	}
+
+	/**
+	 * Sets every owner's property to InFunction(Owner, CurrentValue). The function runs on worker threads and must
+	 * only read from the owner it is given. Returns the number of properties that changed.
+	 */
+	template<typename InOwnerType, typename InValueType, typename InPrivateType, typename InFunctionType>
+	static int32 Update(TArrayView<TIdentity_T<InOwnerType>* const> InOwners, TSimpleProperty<InValueType, InPrivateType> InOwnerType::* InMember,
+		InFunctionType&& InFunction, ESimplePropertyBulkDispatch InDispatch = ESimplePropertyBulkDispatch::Serial,
+		int32 InMinBatchSize = DefaultMinBatchSize)
+	{
+		const int32 NumOwners = InOwners.Num();
+
+		if (NumOwners == 0)
+		{
+			return 0;
+		}
+
+		// One byte per owner so workers never share a word the way they would with a bit array.
+		TArray<uint8> Changed;
+		Changed.SetNumZeroed(NumOwners);
+
+		ParallelFor(TEXT("SimplePropertyBulkStore"), NumOwners, InMinBatchSize,
+			[&InOwners, InMember, &InFunction, &Changed](int32 InIndex)
+			{
+				InOwnerType& Owner = *InOwners[InIndex];
+				TSimpleProperty<InValueType, InPrivateType>& Property = Owner.*InMember;
+
+				Changed[InIndex] = FSimplePropertyAccess::SetValueSilently(Property,
+					InFunction(static_cast<const InOwnerType&>(Owner), FSimplePropertyAccess::GetValue(Property)));
+			});
+
+		TArray<int32> ChangedIndices;
+
+		for (int32 Index = 0; Index < NumOwners; ++Index)
+		{
+			if (Changed[Index])
+			{
+				ChangedIndices.Add(Index);
+			}
+		}
+
+		Dispatch(InOwners, InMember, ChangedIndices, InDispatch, InMinBatchSize);
+		return ChangedIndices.Num();
+	}
+
+protected:
+	template<typename InOwnerType, typename InPropertyType>
+	static void Dispatch(TArrayView<InOwnerType* const> InOwners, InPropertyType InOwnerType::* InMember,
+		const TArray<int32>& InChangedIndices, ESimplePropertyBulkDispatch InDispatch, int32 InMinBatchSize)
+	{
+		switch (InDispatch)
+		{
+			case ESimplePropertyBulkDispatch::Serial:
+				for (const int32 Index : InChangedIndices)
+				{
+					FSimplePropertyAccess::NotifyChanged(InOwners[Index]->*InMember);
+				}
+				break;
+
+			case ESimplePropertyBulkDispatch::Parallel:
+			{
+				TArray<int32> ConcurrentIndices;
+				TArray<int32> SerialIndices;
+
+				for (const int32 Index : InChangedIndices)
+				{
+					if (FSimplePropertyAccess::CanNotifyConcurrently(InOwners[Index]->*InMember))
+					{
+						ConcurrentIndices.Add(Index);
+					}
+					else
+					{
+						SerialIndices.Add(Index);
+					}
+				}
+
+				ParallelFor(TEXT("SimplePropertyBulkDispatch"), ConcurrentIndices.Num(), InMinBatchSize,
+					[&InOwners, InMember, &ConcurrentIndices](int32 InIndex)
+					{
+						FSimplePropertyAccess::NotifyChanged(InOwners[ConcurrentIndices[InIndex]]->*InMember);
+					});
+
+				for (const int32 Index : SerialIndices)
+				{
+					FSimplePropertyAccess::NotifyChanged(InOwners[Index]->*InMember);
+				}
+
+				break;
+			}
+		}
+	}
+};
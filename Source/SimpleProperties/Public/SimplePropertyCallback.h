@@ -0,0 +1,457 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/StringConv.h"
+#include "Containers/UnrealString.h"
+#include "Delegates/Delegate.h"
+#include "HAL/UnrealMemory.h"
+#include "Misc/AssertionMacros.h"
+#include "SimplePropertiesFwd.h"
+#include "Templates/Tuple.h"
+#include "Templates/UnrealTemplate.h"
+#include <type_traits>
+
+#if !UE_BUILD_SHIPPING || SIMPLE_PROPERTIES_WITH_MIRROR
+namespace UE::SimpleProperties::Private
+{
+#if !UE_BUILD_SHIPPING
+	/** Resolves a function address to its symbol name, for diagnostics. */
+	SIMPLEPROPERTIES_API void DescribeFunction(const void* InFunction, FString& OutDescription);
+
+	/**
+	 * The code address a member function pointer calls on InObject, virtual calls resolved through the object's
+	 * vtable. Relies on the platform ABI's pointer layout, so it's for diagnostics only.
+	 */
+	template<typename InClassType, typename InMethodType>
+	const void* GetMethodAddress(const InClassType* InObject, InMethodType InMethod)
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		// The first word is the function, or a thunk that makes the virtual call.
+		const void* Function = nullptr;
+		FMemory::Memcpy(&Function, &InMethod, sizeof(Function));
+		return Function;
+#else
+		// Itanium: {function or vtable offset, this adjustment}. The ARM variant flags virtuals in the adjustment.
+		struct FParts
+		{
+			UPTRINT Pointer;
+			PTRINT Adjustment;
+		};
+
+		static_assert(sizeof(InMethodType) == sizeof(FParts));
+
+		FParts Parts;
+		FMemory::Memcpy(&Parts, &InMethod, sizeof(Parts));
+
+#if PLATFORM_CPU_ARM_FAMILY
+		const bool bVirtual = (Parts.Adjustment & 1) != 0;
+		const PTRINT Adjustment = Parts.Adjustment >> 1;
+		const UPTRINT VTableOffset = Parts.Pointer;
+#else
+		const bool bVirtual = (Parts.Pointer & 1) != 0;
+		const PTRINT Adjustment = Parts.Adjustment;
+		const UPTRINT VTableOffset = Parts.Pointer - 1;
+#endif
+
+		if (!bVirtual)
+		{
+			return reinterpret_cast<const void*>(Parts.Pointer);
+		}
+
+		if (!InObject)
+		{
+			return nullptr;
+		}
+
+		const uint8* This = reinterpret_cast<const uint8*>(InObject) + Adjustment;
+		const uint8* VTable = *reinterpret_cast<const uint8* const*>(This);
+		return *reinterpret_cast<const void* const*>(VTable + VTableOffset);
+#endif
+	}
+#endif
+
+	/** The compiler's signature for this function, which includes the type name. For diagnostics only. */
+	template<typename InType>
+	const ANSICHAR* GetTypeName()
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		return __FUNCSIG__;
+#else
+		return __PRETTY_FUNCTION__;
+#endif
+	}
+}
+#endif
+
+/**
+ * Delegate-like callback that stores its binding in a fixed inline buffer and never allocates.
+ * Bindings that don't fit fail to compile. To store one on the heap anyway, create the engine delegate
+ * yourself (FDelegate::CreateRaw etc.) and pass that in - that is the explicit opt-in.
+ */
+template<typename InRetType, typename... InParamTypes, uint32 InInlineBytes>
+class TSimplePropertyCallback<InRetType(InParamTypes...), InInlineBytes>
+{
+public:
+	using FDelegate = TDelegate<InRetType(InParamTypes...)>;
+
+	static constexpr uint32 InlineBytes = InInlineBytes;
+	static constexpr uint32 InlineAlignment = 8;
+
+	template<typename InBindingType>
+	static constexpr bool TFitsInline = sizeof(InBindingType) <= InlineBytes && alignof(InBindingType) <= InlineAlignment;
+
+	TSimplePropertyCallback() = default;
+
+	// Heap opt-in: the delegate allocates its own payload, we just hold the delegate.
+	TSimplePropertyCallback(FDelegate InDelegate)
+	{
+		if (InDelegate.IsBound())
+		{
+			Emplace<FDelegateBinding>(MoveTemp(InDelegate));
+		}
+	}
+
+	TSimplePropertyCallback(const TSimplePropertyCallback& InOther)
+	{
+		CopyFrom(InOther);
+	}
+
+	TSimplePropertyCallback(TSimplePropertyCallback&& InOther)
+	{
+		MoveFrom(InOther);
+	}
+
+	~TSimplePropertyCallback()
+	{
+		Unbind();
+	}
+
+	TSimplePropertyCallback& operator=(const TSimplePropertyCallback& InOther)
+	{
+		if (this != &InOther)
+		{
+			Unbind();
+			CopyFrom(InOther);
+		}
+
+		return *this;
+	}
+
+	TSimplePropertyCallback& operator=(TSimplePropertyCallback&& InOther)
+	{
+		if (this != &InOther)
+		{
+			Unbind();
+			MoveFrom(InOther);
+		}
+
+		return *this;
+	}
+
+	template<typename InFunctorType, typename... InPayloadTypes>
+	UE_NODISCARD static TSimplePropertyCallback CreateLambda(InFunctorType&& InFunctor, InPayloadTypes&&... InPayload)
+	{
+		using FBinding = TFunctorBinding<std::decay_t<InFunctorType>, std::decay_t<InPayloadTypes>...>;
+		static_assert(TFitsInline<FBinding>, "Callback payload does not fit in SIMPLE_PROPERTIES_CALLBACK_INLINE_BYTES. "
+			"Raise the limit or pass an explicitly created FDelegate to store it on the heap.");
+
+		TSimplePropertyCallback Callback;
+		Callback.Emplace<FBinding>(Forward<InFunctorType>(InFunctor), Forward<InPayloadTypes>(InPayload)...);
+		return Callback;
+	}
+
+	template<typename InFunctionType, typename... InPayloadTypes>
+	UE_NODISCARD static TSimplePropertyCallback CreateStatic(InFunctionType InFunction, InPayloadTypes&&... InPayload)
+	{
+		return CreateLambda(InFunction, Forward<InPayloadTypes>(InPayload)...);
+	}
+
+	template<typename InClassType, typename InMethodType, typename... InPayloadTypes>
+	UE_NODISCARD static TSimplePropertyCallback CreateRaw(InClassType* InObject, InMethodType InMethod, InPayloadTypes&&... InPayload)
+	{
+		using FBinding = TRawBinding<InClassType, InMethodType, std::decay_t<InPayloadTypes>...>;
+		static_assert(TFitsInline<FBinding>, "Callback payload does not fit in SIMPLE_PROPERTIES_CALLBACK_INLINE_BYTES. "
+			"Raise the limit or pass an explicitly created FDelegate to store it on the heap.");
+
+		TSimplePropertyCallback Callback;
+		Callback.Emplace<FBinding>(InObject, InMethod, Forward<InPayloadTypes>(InPayload)...);
+		return Callback;
+	}
+
+	bool IsBound() const
+	{
+		return Ops && Ops->IsBound(Storage);
+	}
+
+	InRetType Execute(InParamTypes... InParams) const
+	{
+		check(Ops);
+		return Ops->Invoke(Storage, Forward<InParamTypes>(InParams)...);
+	}
+
+	bool ExecuteIfBound(InParamTypes... InParams) const
+	{
+		static_assert(std::is_void_v<InRetType>, "ExecuteIfBound is only available for callbacks returning void.");
+
+		if (IsBound())
+		{
+			Ops->Invoke(Storage, Forward<InParamTypes>(InParams)...);
+			return true;
+		}
+
+		return false;
+	}
+
+	void Unbind()
+	{
+		if (Ops)
+		{
+			Ops->Destruct(Storage);
+			Ops = nullptr;
+		}
+	}
+
+	/** Marks the bound function as safe to run concurrently with other callbacks, e.g. from a parallel bulk dispatch. */
+	TSimplePropertyCallback& MarkThreadSafe()
+	{
+		if (Ops)
+		{
+			Ops = Ops->ThreadSafeOps;
+		}
+
+		return *this;
+	}
+
+	bool IsThreadSafe() const
+	{
+		return Ops && Ops->bThreadSafe;
+	}
+
+#if !UE_BUILD_SHIPPING
+	/** Describes the bound function for logging. Not cheap. */
+	FString Describe() const
+	{
+		FString Description;
+
+		if (Ops)
+		{
+			Ops->Describe(Storage, Description);
+		}
+		else
+		{
+			Description = TEXT("Unbound");
+		}
+
+		return Description;
+	}
+#endif
+
+protected:
+	struct FOps
+	{
+		InRetType (*Invoke)(void* InStorage, InParamTypes... InParams);
+		void (*CopyConstruct)(void* InDest, const void* InSource);
+		void (*MoveConstruct)(void* InDest, void* InSource);
+		void (*Destruct)(void* InStorage);
+		bool (*IsBound)(const void* InStorage);
+
+#if !UE_BUILD_SHIPPING
+		void (*Describe)(const void* InStorage, FString& OutDescription);
+#endif
+
+		// The thread-safety mark is part of the table, so it costs the callback no storage.
+		bool bThreadSafe;
+		const FOps* ThreadSafeOps;
+	};
+
+	template<typename InFunctorType, typename... InPayloadTypes>
+	struct TFunctorBinding
+	{
+		InFunctorType Functor;
+		TTuple<InPayloadTypes...> Payload;
+
+		template<typename InFunctorArgType, typename... InPayloadArgTypes>
+		TFunctorBinding(InFunctorArgType&& InFunctor, InPayloadArgTypes&&... InPayload)
+			: Functor(Forward<InFunctorArgType>(InFunctor))
+			, Payload(Forward<InPayloadArgTypes>(InPayload)...)
+		{
+		}
+
+		InRetType Invoke(InParamTypes... InParams)
+		{
+			return Payload.ApplyAfter(Functor, Forward<InParamTypes>(InParams)...);
+		}
+
+		bool IsBound() const
+		{
+			return true;
+		}
+
+#if !UE_BUILD_SHIPPING
+		void Describe(FString& OutDescription) const
+		{
+			if constexpr (std::is_pointer_v<InFunctorType>)
+			{
+				UE::SimpleProperties::Private::DescribeFunction(reinterpret_cast<const void*>(Functor), OutDescription);
+			}
+			else
+			{
+				OutDescription = ANSI_TO_TCHAR(UE::SimpleProperties::Private::GetTypeName<InFunctorType>());
+			}
+		}
+#endif
+	};
+
+	template<typename InClassType, typename InMethodType, typename... InPayloadTypes>
+	struct TRawBinding
+	{
+		InClassType* Object;
+		InMethodType Method;
+		TTuple<InPayloadTypes...> Payload;
+
+		template<typename... InPayloadArgTypes>
+		TRawBinding(InClassType* InObject, InMethodType InMethod, InPayloadArgTypes&&... InPayload)
+			: Object(InObject)
+			, Method(InMethod)
+			, Payload(Forward<InPayloadArgTypes>(InPayload)...)
+		{
+		}
+
+		InRetType Invoke(InParamTypes... InParams)
+		{
+			return Payload.ApplyAfter(Method, Object, Forward<InParamTypes>(InParams)...);
+		}
+
+		bool IsBound() const
+		{
+			return Object != nullptr;
+		}
+
+#if !UE_BUILD_SHIPPING
+		void Describe(FString& OutDescription) const
+		{
+			FString Function;
+
+			if (const void* Address = UE::SimpleProperties::Private::GetMethodAddress(Object, Method))
+			{
+				UE::SimpleProperties::Private::DescribeFunction(Address, Function);
+			}
+			else
+			{
+				Function = ANSI_TO_TCHAR(UE::SimpleProperties::Private::GetTypeName<InMethodType>());
+			}
+
+			OutDescription = FString::Printf(TEXT("%s on 0x%p"), *Function, Object);
+		}
+#endif
+	};
+
+	struct FDelegateBinding
+	{
+		FDelegate Delegate;
+
+		FDelegateBinding(FDelegate&& InDelegate)
+			: Delegate(MoveTemp(InDelegate))
+		{
+		}
+
+		InRetType Invoke(InParamTypes... InParams)
+		{
+			return Delegate.Execute(Forward<InParamTypes>(InParams)...);
+		}
+
+		bool IsBound() const
+		{
+			return Delegate.IsBound();
+		}
+
+#if !UE_BUILD_SHIPPING
+		void Describe(FString& OutDescription) const
+		{
+#if USE_DELEGATE_TRYGETBOUNDFUNCTIONNAME
+			OutDescription = Delegate.TryGetBoundFunctionName().ToString();
+#else
+			OutDescription = TEXT("Delegate");
+#endif
+		}
+#endif
+	};
+
+	template<typename InBindingType>
+	struct TOps
+	{
+		static InRetType Invoke(void* InStorage, InParamTypes... InParams)
+		{
+			return static_cast<InBindingType*>(InStorage)->Invoke(Forward<InParamTypes>(InParams)...);
+		}
+
+		static void CopyConstruct(void* InDest, const void* InSource)
+		{
+			new (InDest) InBindingType(*static_cast<const InBindingType*>(InSource));
+		}
+
+		static void MoveConstruct(void* InDest, void* InSource)
+		{
+			new (InDest) InBindingType(MoveTemp(*static_cast<InBindingType*>(InSource)));
+		}
+
+		static void Destruct(void* InStorage)
+		{
+			static_cast<InBindingType*>(InStorage)->~InBindingType();
+		}
+
+		static bool IsBound(const void* InStorage)
+		{
+			return static_cast<const InBindingType*>(InStorage)->IsBound();
+		}
+
+#if !UE_BUILD_SHIPPING
+		static void Describe(const void* InStorage, FString& OutDescription)
+		{
+			static_cast<const InBindingType*>(InStorage)->Describe(OutDescription);
+		}
+
+		static constexpr FOps ThreadSafeTable = {&Invoke, &CopyConstruct, &MoveConstruct, &Destruct, &IsBound, &Describe,
+			true, &ThreadSafeTable};
+		static constexpr FOps Table = {&Invoke, &CopyConstruct, &MoveConstruct, &Destruct, &IsBound, &Describe,
+			false, &ThreadSafeTable};
+#else
+		static constexpr FOps ThreadSafeTable = {&Invoke, &CopyConstruct, &MoveConstruct, &Destruct, &IsBound,
+			true, &ThreadSafeTable};
+		static constexpr FOps Table = {&Invoke, &CopyConstruct, &MoveConstruct, &Destruct, &IsBound,
+			false, &ThreadSafeTable};
+#endif
+	};
+
+	const FOps* Ops = nullptr;
+	alignas(InlineAlignment) mutable uint8 Storage[InlineBytes];
+
+	template<typename InBindingType, typename... InArgTypes>
+	void Emplace(InArgTypes&&... InArgs)
+	{
+		static_assert(TFitsInline<InBindingType>);
+
+		new (Storage) InBindingType(Forward<InArgTypes>(InArgs)...);
+		Ops = &TOps<InBindingType>::Table;
+	}
+
+	void CopyFrom(const TSimplePropertyCallback& InOther)
+	{
+		if (InOther.Ops)
+		{
+			InOther.Ops->CopyConstruct(Storage, InOther.Storage);
+			Ops = InOther.Ops;
+		}
+	}
+
+	void MoveFrom(TSimplePropertyCallback& InOther)
+	{
+		if (InOther.Ops)
+		{
+			InOther.Ops->MoveConstruct(Storage, InOther.Storage);
+			Ops = InOther.Ops;
+			InOther.Unbind();
+		}
+	}
+};
@@ -40,6 +40,15 @@ struct CCanFindInnerPropertyInstance
 	);
 };
 
+// USTRUCTs
+struct CHasStaticStruct
+{
+	template<typename InValueType>
+	auto Requires(const void*& Result) -> decltype(
+		Result = InValueType::StaticStruct()
+	);
+};
+
 struct CIsLambdaFunction
 {
 	template<typename InFunctionType>
@@ -0,0 +1,379 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Containers/Set.h"
+#include "SimplePropertyCallback.h"
+#include "SimplePropertyTypeTraits.h"
+#include "Templates/UnrealTemplate.h"
+
+enum class ESimplePropertyContainerChangeType : uint8
+{
+	Add,
+	Remove,
+	Set,
+	Reset
+};
+
+// Index is the index that was added, removed or set. Reset uses INDEX_NONE.
+struct FSimplePropertyArrayChange
+{
+	ESimplePropertyContainerChangeType Type;
+	int32 Index;
+};
+
+// Key is the key/element that was added, removed or set. Reset has no key.
+template<typename InKeyType>
+struct TSimplePropertyKeyedChange
+{
+	ESimplePropertyContainerChangeType Type;
+	const InKeyType* Key;
+};
+
+/**
+ * Array property with element-level change events. The array can only be mutated through this API so that
+ * every change is reported, and changes are detected per element rather than by comparing whole arrays.
+ *
+ * The array, map and set properties call their callback directly for each change. They don't take part in the
+ * change wave guard (FSimplePropertyPropagation), so mutating a container from its own callback recurses, and they
+ * support neither transactions nor the property hooks (mirror, journal, push model, buffering, awaiting).
+ */
+template<typename InElementType, typename InAllocatorType>
+struct TSimpleArrayProperty
+{
+	using FElementType = InElementType;
+	using FArrayType = TArray<InElementType, InAllocatorType>;
+	using FChange = FSimplePropertyArrayChange;
+	using FOnCallback = TSimplePropertyCallback<void(const FChange&)>;
+	using FComparatorType = TSimplePropertyTypeTraits<FElementType>::template FComparatorType;
+
+	TSimpleArrayProperty() = default;
+
+	TSimpleArrayProperty(FArrayType InValue)
+		: Value(MoveTemp(InValue))
+	{
+	}
+
+	TSimpleArrayProperty(FArrayType InValue, FOnCallback InCallback)
+		: Value(MoveTemp(InValue))
+		, OnChangeCallback(MoveTemp(InCallback))
+	{
+	}
+
+	operator const FArrayType&() const
+	{
+		return Value;
+	}
+
+	const FArrayType& operator*() const
+	{
+		return Value;
+	}
+
+	const FArrayType* operator->() const
+	{
+		return &Value;
+	}
+
+	const FElementType& operator[](int32 InIndex) const
+	{
+		return Value[InIndex];
+	}
+
+	int32 Num() const
+	{
+		return Value.Num();
+	}
+
+	template<typename InAssignType>
+	int32 Add(InAssignType&& InElement)
+	{
+		const int32 Index = Value.Add(Forward<InAssignType>(InElement));
+		OnChange({ESimplePropertyContainerChangeType::Add, Index});
+		return Index;
+	}
+
+	template<typename InAssignType>
+	void Insert(InAssignType&& InElement, int32 InIndex)
+	{
+		Value.Insert(Forward<InAssignType>(InElement), InIndex);
+		OnChange({ESimplePropertyContainerChangeType::Add, InIndex});
+	}
+
+	/** Returns true if the element was different. */
+	template<typename InAssignType>
+	bool SetAt(int32 InIndex, InAssignType&& InElement)
+	{
+		FElementType& Element = Value[InIndex];
+
+		if (FComparatorType::template IsEqual<FElementType>(Element, InElement))
+		{
+			return false;
+		}
+
+		Element = Forward<InAssignType>(InElement);
+		OnChange({ESimplePropertyContainerChangeType::Set, InIndex});
+		return true;
+	}
+
+	void RemoveAt(int32 InIndex)
+	{
+		Value.RemoveAt(InIndex);
+		OnChange({ESimplePropertyContainerChangeType::Remove, InIndex});
+	}
+
+	/** Removes the first matching element. Returns true if one was found. */
+	bool RemoveSingle(const FElementType& InElement)
+	{
+		const int32 Index = Value.IndexOfByKey(InElement);
+
+		if (Index == INDEX_NONE)
+		{
+			return false;
+		}
+
+		RemoveAt(Index);
+		return true;
+	}
+
+	void Reset()
+	{
+		if (Value.IsEmpty())
+		{
+			return;
+		}
+
+		Value.Reset();
+		OnChange({ESimplePropertyContainerChangeType::Reset, INDEX_NONE});
+	}
+
+	void SetOnChange(FOnCallback InCallback)
+	{
+		OnChangeCallback = MoveTemp(InCallback);
+	}
+
+protected:
+	FArrayType Value;
+	FOnCallback OnChangeCallback;
+
+	void OnChange(const FChange& InChange)
+	{
+		OnChangeCallback.ExecuteIfBound(InChange);
+	}
+};
+
+/** Map property with per-key change events. Called directly, like the array property's. */
+template<typename InKeyType, typename InValueType>
+struct TSimpleMapProperty
+{
+	using FKeyType = InKeyType;
+	using FValueType = InValueType;
+	using FMapType = TMap<InKeyType, InValueType>;
+	using FChange = TSimplePropertyKeyedChange<InKeyType>;
+	using FOnCallback = TSimplePropertyCallback<void(const FChange&)>;
+	using FComparatorType = TSimplePropertyTypeTraits<FValueType>::template FComparatorType;
+
+	TSimpleMapProperty() = default;
+
+	TSimpleMapProperty(FMapType InValue)
+		: Value(MoveTemp(InValue))
+	{
+	}
+
+	TSimpleMapProperty(FMapType InValue, FOnCallback InCallback)
+		: Value(MoveTemp(InValue))
+		, OnChangeCallback(MoveTemp(InCallback))
+	{
+	}
+
+	operator const FMapType&() const
+	{
+		return Value;
+	}
+
+	const FMapType& operator*() const
+	{
+		return Value;
+	}
+
+	const FMapType* operator->() const
+	{
+		return &Value;
+	}
+
+	int32 Num() const
+	{
+		return Value.Num();
+	}
+
+	const FValueType* Find(const FKeyType& InKey) const
+	{
+		return Value.Find(InKey);
+	}
+
+	/** Adds or replaces the value for the key. Returns true if anything changed. */
+	template<typename InAssignType>
+	bool Add(const FKeyType& InKey, InAssignType&& InValue)
+	{
+		if (FValueType* Existing = Value.Find(InKey))
+		{
+			if (FComparatorType::template IsEqual<FValueType>(*Existing, InValue))
+			{
+				return false;
+			}
+
+			*Existing = Forward<InAssignType>(InValue);
+			OnChange({ESimplePropertyContainerChangeType::Set, &InKey});
+			return true;
+		}
+
+		Value.Add(InKey, Forward<InAssignType>(InValue));
+		OnChange({ESimplePropertyContainerChangeType::Add, &InKey});
+		return true;
+	}
+
+	/** Returns true if the key was present. */
+	bool Remove(const FKeyType& InKey)
+	{
+		// InKey may be the stored key (Map.Remove(It.Key())), which the removal destroys.
+		const FKeyType RemovedKey = InKey;
+
+		if (Value.Remove(RemovedKey) == 0)
+		{
+			return false;
+		}
+
+		OnChange({ESimplePropertyContainerChangeType::Remove, &RemovedKey});
+		return true;
+	}
+
+	void Reset()
+	{
+		if (Value.IsEmpty())
+		{
+			return;
+		}
+
+		Value.Reset();
+		OnChange({ESimplePropertyContainerChangeType::Reset, nullptr});
+	}
+
+	void SetOnChange(FOnCallback InCallback)
+	{
+		OnChangeCallback = MoveTemp(InCallback);
+	}
+
+protected:
+	FMapType Value;
+	FOnCallback OnChangeCallback;
+
+	void OnChange(const FChange& InChange)
+	{
+		OnChangeCallback.ExecuteIfBound(InChange);
+	}
+};
+
+/** Set property with per-element change events. Called directly, like the array property's. */
+template<typename InElementType>
+struct TSimpleSetProperty
+{
+	using FElementType = InElementType;
+	using FSetType = TSet<InElementType>;
+	using FChange = TSimplePropertyKeyedChange<InElementType>;
+	using FOnCallback = TSimplePropertyCallback<void(const FChange&)>;
+
+	TSimpleSetProperty() = default;
+
+	TSimpleSetProperty(FSetType InValue)
+		: Value(MoveTemp(InValue))
+	{
+	}
+
+	TSimpleSetProperty(FSetType InValue, FOnCallback InCallback)
+		: Value(MoveTemp(InValue))
+		, OnChangeCallback(MoveTemp(InCallback))
+	{
+	}
+
+	operator const FSetType&() const
+	{
+		return Value;
+	}
+
+	const FSetType& operator*() const
+	{
+		return Value;
+	}
+
+	const FSetType* operator->() const
+	{
+		return &Value;
+	}
+
+	int32 Num() const
+	{
+		return Value.Num();
+	}
+
+	bool Contains(const FElementType& InElement) const
+	{
+		return Value.Contains(InElement);
+	}
+
+	/** Returns true if the element wasn't already in the set. */
+	bool Add(const FElementType& InElement)
+	{
+		bool bAlreadyInSet = false;
+		Value.Add(InElement, &bAlreadyInSet);
+
+		if (bAlreadyInSet)
+		{
+			return false;
+		}
+
+		OnChange({ESimplePropertyContainerChangeType::Add, &InElement});
+		return true;
+	}
+
+	/** Returns true if the element was present. */
+	bool Remove(const FElementType& InElement)
+	{
+		// InElement may be the stored element, which the removal destroys.
+		const FElementType RemovedElement = InElement;
+
+		if (Value.Remove(RemovedElement) == 0)
+		{
+			return false;
+		}
+
+		OnChange({ESimplePropertyContainerChangeType::Remove, &RemovedElement});
+		return true;
+	}
+
+	void Reset()
+	{
+		if (Value.IsEmpty())
+		{
+			return;
+		}
+
+		Value.Reset();
+		OnChange({ESimplePropertyContainerChangeType::Reset, nullptr});
+	}
+
+	void SetOnChange(FOnCallback InCallback)
+	{
+		OnChangeCallback = MoveTemp(InCallback);
+	}
+
+protected:
+	FSetType Value;
+	FOnCallback OnChangeCallback;
+
+	void OnChange(const FChange& InChange)
+	{
+		OnChangeCallback.ExecuteIfBound(InChange);
+	}
+};
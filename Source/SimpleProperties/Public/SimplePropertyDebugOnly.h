@@ -0,0 +1,133 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "SimpleProperty.h"
+
+// Debug-only properties (TSimpleDebugProperty, TSimpleDebugConstProperty) are full properties in development builds
+// and compile down to the raw value when this is on. Set it to 0 in your Target.cs to keep them in shipping.
+#ifndef SIMPLE_PROPERTIES_STRIP_DEBUG_PROPERTIES
+#define SIMPLE_PROPERTIES_STRIP_DEBUG_PROPERTIES UE_BUILD_SHIPPING
+#endif
+
+#if SIMPLE_PROPERTIES_STRIP_DEBUG_PROPERTIES && WITH_EDITOR
+#error "Debug-only properties can't be stripped in editor builds, the editor relies on their transaction support."
+#endif
+
+/**
+ * The value and nothing else. Accepts the same constructors, sets and callbacks as TSimpleConstProperty so that it
+ * can stand in for one, but callbacks are discarded and a set is a plain store with no comparison.
+ *
+ * Used by the debug-only aliases below in stripped builds. Not supported by the batch systems (layouts, bulk
+ * updates, journal, mirror), which need the change path.
+ */
+template<typename InValueType, typename InPrivateType = UE::SimpleProperties::NoType>
+struct TSimpleRawConstProperty : public TSimplePropertyBase<InValueType>
+{
+	using Base = TSimplePropertyBase<InValueType>;
+	using FValueType = Base::template FValueType;
+	using FPrivateType = InPrivateType;
+
+	TSimpleRawConstProperty() = default;
+
+	TSimpleRawConstProperty(FSimplePropertyOnChange&& InUpdateFunc)
+		: Base()
+	{
+	}
+
+	template<typename InAssignType
+		UE_REQUIRES(std::negation_v<std::is_same<std::decay_t<InAssignType>, FSimplePropertyOnChange>>)>
+	TSimpleRawConstProperty(InAssignType&& InDefaultValue)
+		: Base(FValueType(Forward<InAssignType>(InDefaultValue)))
+	{
+	}
+
+	template<typename InAssignType
+		UE_REQUIRES(std::negation_v<std::is_same<std::decay_t<InAssignType>, FSimplePropertyOnChange>>)>
+	TSimpleRawConstProperty(InAssignType&& InDefaultValue, FSimplePropertyOnChange&& InUpdateFunc)
+		: Base(FValueType(Forward<InAssignType>(InDefaultValue)))
+	{
+	}
+
+	template<typename InAssignType>
+	bool Set(FPrivateType Private, InAssignType&& InValue)
+	{
+		static_assert(!std::is_same_v<FPrivateType, UE::SimpleProperties::NoType>);
+		Base::Value = Forward<InAssignType>(InValue);
+		return true;
+	}
+
+	void OnChange(ESimplePropertyChangeEventType InParam = ESimplePropertyChangeEventType::ExecuteIfBound)
+	{
+	}
+
+	void SetOnChange(FSimplePropertyOnChange InCallback)
+	{
+	}
+};
+
+template<typename InValueType, typename InPrivateType = UE::SimpleProperties::NoType>
+struct TSimpleRawProperty : public TSimpleRawConstProperty<InValueType, InPrivateType>
+{
+	using Super = TSimpleRawConstProperty<InValueType, InPrivateType>;
+	using Base = Super::template Base;
+	using FValueType = Base::template FValueType;
+	using FValueTypes = Base::template FValueTypes;
+	using FReferenceType = Base::template FReferenceType;
+	using FPointerType = Base::template FPointerType;
+
+	using Super::Super;
+
+	template<typename InAssignType>
+	bool operator=(InAssignType&& InValue)
+	{
+		Base::Value = Forward<InAssignType>(InValue);
+		return true;
+	}
+
+	operator FReferenceType&()
+	{
+		return FValueTypes::GetReferenceValue(Base::Value);
+	}
+
+	FReferenceType& operator*()
+	{
+		return FValueTypes::GetReferenceValue(Base::Value);
+	}
+
+	FPointerType* operator->()
+	{
+		return FValueTypes::GetPointerValue(Base::Value);
+	}
+};
+
+static_assert(sizeof(TSimpleRawProperty<bool>) == sizeof(bool));
+static_assert(sizeof(TSimpleRawProperty<uint8>) == sizeof(uint8));
+static_assert(sizeof(TSimpleRawProperty<int32>) == sizeof(int32));
+static_assert(sizeof(TSimpleRawProperty<int64>) == sizeof(int64));
+static_assert(sizeof(TSimpleRawProperty<float>) == sizeof(float));
+static_assert(sizeof(TSimpleRawProperty<double>) == sizeof(double));
+static_assert(sizeof(TSimpleRawProperty<UObject*>) == sizeof(UObject*));
+static_assert(alignof(TSimpleRawProperty<double>) == alignof(double));
+
+/**
+ * For properties whose change tracking is only wanted while developing - debug displays, cheats, editor feedback.
+ * Full properties in development builds, the raw value (sizeof(TSimpleDebugProperty<T>) == sizeof(T)) when
+ * SIMPLE_PROPERTIES_STRIP_DEBUG_PROPERTIES is on. Don't rely on their callbacks for gameplay.
+ */
+#if SIMPLE_PROPERTIES_STRIP_DEBUG_PROPERTIES
+template<typename InValueType, typename InPrivateType = UE::SimpleProperties::NoType>
+using TSimpleDebugConstProperty = TSimpleRawConstProperty<InValueType, InPrivateType>;
+
+template<typename InValueType, typename InPrivateType = UE::SimpleProperties::NoType>
+using TSimpleDebugProperty = TSimpleRawProperty<InValueType, InPrivateType>;
+
+static_assert(sizeof(TSimpleDebugProperty<float>) == sizeof(float));
+static_assert(sizeof(TSimpleDebugProperty<int32>) == sizeof(int32));
+#else
+template<typename InValueType, typename InPrivateType = UE::SimpleProperties::NoType>
+using TSimpleDebugConstProperty = TSimpleConstProperty<InValueType, InPrivateType>;
+
+template<typename InValueType, typename InPrivateType = UE::SimpleProperties::NoType>
+using TSimpleDebugProperty = TSimpleProperty<InValueType, InPrivateType>;
+#endif
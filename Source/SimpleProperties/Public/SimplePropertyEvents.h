@@ -4,33 +4,44 @@
 
 #include "Delegates/Delegate.h"
 #include "Delegates/DelegateCombinations.h"
+#include "SimplePropertyCallback.h"
+#include "SimplePropertyConcepts.h"
 #include "SimplePropertyTemplates.h"
-#include "Templates/UnrealTypeTraits.h"
+#include "Templates/Models.h"
+#include "Templates/Requires.h"
 
 struct FSimplePropertyOnChange
 {
 	DECLARE_DELEGATE(FDelegate)
 
-	FDelegate Callback;
+	using FCallback = TSimplePropertyCallback<void()>;
+
+	FCallback Callback;
 
 	FSimplePropertyOnChange() = delete;
 
+	FSimplePropertyOnChange(FCallback InCallback)
+		: Callback(MoveTemp(InCallback))
+	{
+	}
+
+	// Explicit heap opt-in for payloads that don't fit inline.
 	FSimplePropertyOnChange(FDelegate InCallback)
-		: Callback(InCallback)
+		: Callback(MoveTemp(InCallback))
 	{
 	}
 
 	template<typename... InArgsType, typename InFunctionType = void(*)(InArgsType&...)
 		UE_REQUIRES(TModels<CIsLambdaFunction, InFunctionType>::Value)>
 	FSimplePropertyOnChange(InFunctionType InFunction, InArgsType&&... InArgs)
-		: FSimplePropertyOnChange(FDelegate::CreateLambda(InFunction, Forward<InArgsType>(InArgs)...))
+		: FSimplePropertyOnChange(FCallback::CreateLambda(InFunction, Forward<InArgsType>(InArgs)...))
 	{
 	}
 
 	template<typename... InArgsType, typename InFunctionType = void(*)(InArgsType&...)
 		UE_REQUIRES(TIsStaticClassFunction<InFunctionType>::Value)>
 	FSimplePropertyOnChange(InFunctionType InFunction, InArgsType&&... InArgs)
-		: FSimplePropertyOnChange(FDelegate::CreateStatic(InFunction, Forward<InArgsType>(InArgs)...))
+		: FSimplePropertyOnChange(FCallback::CreateStatic(InFunction, Forward<InArgsType>(InArgs)...))
 	{
 	}
 
@@ -38,7 +49,7 @@ struct FSimplePropertyOnChange
 		typename InFunctionType = void(InClassType::*)(InArgsType&&...)
 		UE_REQUIRES(TIsInstanceClassFunction<InFunctionType>::Value)>
 	FSimplePropertyOnChange(InClassType* InObject, InFunctionType InFunction, InArgsType&&... InArgs)
-		: FSimplePropertyOnChange(FDelegate::CreateRaw(InObject, InFunction, Forward<InArgsType>(InArgs)...))
+		: FSimplePropertyOnChange(FCallback::CreateRaw(InObject, InFunction, Forward<InArgsType>(InArgs)...))
 	{
 	}
 };
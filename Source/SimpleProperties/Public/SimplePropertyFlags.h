@@ -0,0 +1,235 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Misc/AssertionMacros.h"
+#include "SimplePropertyCallback.h"
+#include "Templates/UnrealTemplate.h"
+#include <initializer_list>
+#include <type_traits>
+
+/**
+ * Up to 64 boolean properties packed into one word. InFlagType is an enum whose values are bit indices
+ * (0, 1, 2...), not masks.
+ *
+ * Several flags can be set in one call; the old and new words are XORed once and only the flags that changed fire
+ * their callbacks, in bit order. Per-flag callbacks are only stored for flags that have one, so an unbound flag
+ * costs a single bit. Callbacks can set flags but mustn't bind or unbind flag callbacks.
+ *
+ * Flags[EMyFlag::Stunned] returns a handle that is read and assigned like a TSimpleProperty<bool>.
+ *
+ * Unlike TSimpleProperty, the callbacks are called directly. They aren't part of the change wave
+ * (FSimplePropertyPropagation), so a flag callback that sets flags recurses and a storm between flags isn't capped,
+ * and flags have no transactions, undo or hooks (mirror, journal, push model, buffering, awaiting).
+ */
+template<typename InFlagType, typename InStorageType>
+struct TSimpleFlagsProperty
+{
+	static_assert(std::is_enum_v<InFlagType>, "Flags must be an enum of bit indices.");
+	static_assert(std::is_unsigned_v<InStorageType> && sizeof(InStorageType) <= sizeof(uint64), "Flag storage must be an unsigned integer of up to 64 bits.");
+
+	using FFlagType = InFlagType;
+	using FStorageType = InStorageType;
+	using FOnCallback = TSimplePropertyCallback<void()>;
+	using FOnFlagsCallback = TSimplePropertyCallback<void(FStorageType InChangedMask)>;
+
+	static constexpr int32 MaxFlags = sizeof(FStorageType) * 8;
+
+	/** Behaves like a TSimpleProperty<bool> for one flag. */
+	class FFlag
+	{
+	public:
+		FFlag(TSimpleFlagsProperty& InOwner, FFlagType InFlag)
+			: Owner(InOwner)
+			, Flag(InFlag)
+		{
+		}
+
+		FFlag(const FFlag& InOther) = default;
+
+		bool operator=(bool bInValue)
+		{
+			return Owner.Set(Flag, bInValue);
+		}
+
+		/** Flags[A] = Flags[B] assigns the value, the handle keeps referring to its own flag. */
+		FFlag& operator=(const FFlag& InOther)
+		{
+			Owner.Set(Flag, InOther.Owner.Get(InOther.Flag));
+			return *this;
+		}
+
+		operator bool() const
+		{
+			return Owner.Get(Flag);
+		}
+
+		bool operator*() const
+		{
+			return Owner.Get(Flag);
+		}
+
+		void SetOnChange(FOnCallback InCallback)
+		{
+			Owner.SetOnChange(Flag, MoveTemp(InCallback));
+		}
+
+	protected:
+		TSimpleFlagsProperty& Owner;
+		FFlagType Flag;
+	};
+
+	TSimpleFlagsProperty() = default;
+
+	explicit TSimpleFlagsProperty(FStorageType InValue)
+		: Value(InValue)
+	{
+	}
+
+	static constexpr FStorageType GetMask(FFlagType InFlag)
+	{
+		// An out of range flag doesn't compile in a constant expression, the shift would be undefined.
+		if (!std::is_constant_evaluated())
+		{
+			CheckFlag(InFlag);
+		}
+
+		return static_cast<FStorageType>(FStorageType(1) << static_cast<int32>(InFlag));
+	}
+
+	static constexpr FStorageType GetMask(std::initializer_list<FFlagType> InFlags)
+	{
+		FStorageType Mask = 0;
+
+		for (const FFlagType Flag : InFlags)
+		{
+			Mask |= GetMask(Flag);
+		}
+
+		return Mask;
+	}
+
+	FFlag operator[](FFlagType InFlag)
+	{
+		return FFlag(*this, InFlag);
+	}
+
+	bool operator[](FFlagType InFlag) const
+	{
+		return Get(InFlag);
+	}
+
+	bool Get(FFlagType InFlag) const
+	{
+		return (Value & GetMask(InFlag)) != 0;
+	}
+
+	FStorageType GetAll() const
+	{
+		return Value;
+	}
+
+	/** Returns true if the flag changed. */
+	bool Set(FFlagType InFlag, bool bInValue)
+	{
+		const FStorageType Mask = GetMask(InFlag);
+		return SetFlags(Mask, bInValue ? Mask : 0) != 0;
+	}
+
+	/** Sets the bits in InMask to the matching bits of InValues. Returns the mask of flags that changed. */
+	FStorageType SetFlags(FStorageType InMask, FStorageType InValues)
+	{
+		const FStorageType NewValue = (Value & ~InMask) | (InValues & InMask);
+		const FStorageType Changed = Value ^ NewValue;
+
+		if (Changed == 0)
+		{
+			return 0;
+		}
+
+		Value = NewValue;
+		OnChange(Changed);
+		return Changed;
+	}
+
+	FStorageType SetAll(FStorageType InValue)
+	{
+		return SetFlags(~FStorageType(0), InValue);
+	}
+
+	void SetOnChange(FFlagType InFlag, FOnCallback InCallback)
+	{
+		CheckFlag(InFlag);
+		const int32 Bit = static_cast<int32>(InFlag);
+
+		const int32 Index = FlagCallbacks.IndexOfByPredicate([Bit](const FFlagCallback& InFlagCallback)
+			{
+				return InFlagCallback.Bit >= Bit;
+			});
+
+		const bool bExisting = Index != INDEX_NONE && FlagCallbacks[Index].Bit == Bit;
+
+		if (!InCallback.IsBound())
+		{
+			if (bExisting)
+			{
+				FlagCallbacks.RemoveAt(Index);
+				BoundMask &= ~GetMask(InFlag);
+			}
+
+			return;
+		}
+
+		if (bExisting)
+		{
+			FlagCallbacks[Index].Callback = MoveTemp(InCallback);
+		}
+		else
+		{
+			// Kept sorted by bit so callbacks fire in bit order.
+			FlagCallbacks.Insert({Bit, MoveTemp(InCallback)}, Index == INDEX_NONE ? FlagCallbacks.Num() : Index);
+			BoundMask |= GetMask(InFlag);
+		}
+	}
+
+	/** Called once per change with the mask of flags that changed, after the per-flag callbacks. */
+	void SetOnFlagsChange(FOnFlagsCallback InCallback)
+	{
+		OnFlagsChangeCallback = MoveTemp(InCallback);
+	}
+
+protected:
+	static void CheckFlag(FFlagType InFlag)
+	{
+		const int32 Bit = static_cast<int32>(InFlag);
+		check(Bit >= 0 && Bit < MaxFlags);
+	}
+
+	struct FFlagCallback
+	{
+		int32 Bit;
+		FOnCallback Callback;
+	};
+
+	FStorageType Value = 0;
+	FStorageType BoundMask = 0;
+	TArray<FFlagCallback> FlagCallbacks;
+	FOnFlagsCallback OnFlagsChangeCallback;
+
+	void OnChange(FStorageType InChanged)
+	{
+		if (InChanged & BoundMask)
+		{
+			for (const FFlagCallback& FlagCallback : FlagCallbacks)
+			{
+				if (InChanged & (FStorageType(1) << FlagCallback.Bit))
+				{
+					FlagCallback.Callback.ExecuteIfBound();
+				}
+			}
+		}
+
+		OnFlagsChangeCallback.ExecuteIfBound(InChanged);
+	}
+};
@@ -0,0 +1,52 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "SimplePropertyAccess.h"
+#include "Templates/UnrealTypeTraits.h"
+#include "UObject/GarbageCollectionSchema.h"
+#include "UObject/Object.h"
+#include "UObject/ObjectPtr.h"
+
+// Exposes object-reference properties to the garbage collector's schema as plain reference slots, the same way
+// a TObjectPtr UPROPERTY is, so they're traversed in the fast (and parallel) reachability pass instead of through
+// AddStructReferencedObjects one property at a time. Declare them before the class's schema is assembled:
+//
+//	UE::GC::DeclareIntrinsicMembers(AMyActor::StaticClass(), {
+//		SIMPLE_PROPERTY_GC_MEMBER(AMyActor, Target),
+//		SIMPLE_PROPERTY_GC_MEMBER(AMyActor, Owner)
+//	});
+//
+// Properties declared this way shouldn't also be UPROPERTYs with struct ops, or they'll be reported twice.
+// Like any schema reference, the GC may null the value when the object is marked as garbage; that write doesn't
+// go through the property so no change event fires.
+
+template<typename InValueType>
+struct TSimplePropertyIsObjectReference
+{
+	static constexpr bool Value = TIsPointer<InValueType>::Value
+		&& TIsDerivedFrom<typename TRemovePointer<InValueType>::Type, UObject>::Value;
+};
+
+template<typename InValueType>
+struct TSimplePropertyIsObjectReference<TObjectPtr<InValueType>>
+{
+	static constexpr bool Value = true;
+};
+
+namespace UE::SimpleProperties::Private
+{
+	template<typename InOwnerType, typename InPropertyType>
+	UE::GC::FMemberDeclaration DeclareGCMember(const TCHAR* InName, InPropertyType InOwnerType::* InMember,
+		SIZE_T InPropertyOffset)
+	{
+		static_assert(TSimplePropertyIsObjectReference<typename InPropertyType::FValueType>::Value,
+			"Only properties holding a UObject pointer or TObjectPtr can be declared as GC references.");
+
+		return UE::GC::DeclareMember(InName, static_cast<uint32>(FSimplePropertyAccess::GetValueOffset<InPropertyType>(InPropertyOffset)),
+			UE::GC::EMemberType::Reference);
+	}
+}
+
+#define SIMPLE_PROPERTY_GC_MEMBER(Class, Member) \
+	UE::SimpleProperties::Private::DeclareGCMember(TEXT(#Member), &Class::Member, STRUCT_OFFSET(Class, Member))
@@ -0,0 +1,103 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "SimplePropertyAccess.h"
+#include <type_traits>
+
+struct FSimplePropertyHistoryHandle
+{
+	int32 Index = INDEX_NONE;
+
+	bool IsValid() const
+	{
+		return Index != INDEX_NONE;
+	}
+
+	bool operator==(const FSimplePropertyHistoryHandle& InOther) const
+	{
+		return Index == InOther.Index;
+	}
+};
+
+/**
+ * Per-frame value history for rollback. Tracked properties are recorded at each frame boundary into a fixed
+ * number of frames, so memory is NumFrames * sizeof(value) per property. Values are stored centrally, grouped
+ * by size, so recording and rewinding are a handful of tight copy loops rather than per-property calls.
+ *
+ * Only trivially copyable values can be tracked. Tracked properties must be untracked before they are
+ * destroyed or moved. Tracking or untracking clears the recorded frames.
+ */
+class SIMPLEPROPERTIES_API FSimplePropertyHistory
+{
+public:
+	explicit FSimplePropertyHistory(int32 InNumFrames);
+
+	template<typename InValueType, typename InPrivateType>
+	FSimplePropertyHistoryHandle Track(TSimpleConstProperty<InValueType, InPrivateType>& InProperty)
+	{
+		using FPropertyType = TSimpleConstProperty<InValueType, InPrivateType>;
+		using FValueType = typename FPropertyType::FValueType;
+
+		static_assert(std::is_trivially_copyable_v<FValueType>, "Property history only supports trivially copyable values.");
+
+		return TrackInternal(&FSimplePropertyAccess::GetValue(InProperty), sizeof(FValueType), &InProperty,
+			[](void* InTrackedProperty)
+			{
+				FSimplePropertyAccess::NotifyChanged(*static_cast<FPropertyType*>(InTrackedProperty));
+			});
+	}
+
+	void Untrack(FSimplePropertyHistoryHandle InHandle);
+
+	int32 GetNumFrames() const
+	{
+		return NumFrames;
+	}
+
+	/** Copies the current value of every tracked property into the slot for InFrame. */
+	void RecordFrame(int64 InFrame);
+
+	bool HasFrame(int64 InFrame) const;
+
+	/** Writes the values recorded at InFrame back into the properties. Doesn't fire change events. */
+	bool Rewind(int64 InFrame);
+
+	/** After re-simulating to InFrame, finds the properties whose live value differs from the recorded one. */
+	void FindMispredictions(int64 InFrame, TArray<FSimplePropertyHistoryHandle>& OutMispredicted) const;
+
+	/** Fires the change event of a tracked property, e.g. for each misprediction after a rewind. */
+	void NotifyChanged(FSimplePropertyHistoryHandle InHandle) const;
+
+protected:
+	// All tracked values of one size. Frames is laid out [FrameSlot][Entry].
+	struct FBucket
+	{
+		int32 ValueSize = 0;
+		TArray<void*> Values;
+		TArray<int32> Handles;
+		TArray<uint8> Frames;
+	};
+
+	struct FEntry
+	{
+		int32 Bucket = INDEX_NONE;
+		int32 Slot = INDEX_NONE;
+		void* Property = nullptr;
+		void (*NotifyChanged)(void* InProperty) = nullptr;
+	};
+
+	int32 NumFrames;
+	TArray<int64> FrameNumbers;
+	TArray<FBucket> Buckets;
+	TArray<FEntry> Entries;
+	TArray<int32> FreeEntries;
+
+	FSimplePropertyHistoryHandle TrackInternal(void* InValue, int32 InValueSize, void* InProperty,
+		void (*InNotifyChanged)(void* InProperty));
+
+	int32 GetFrameSlot(int64 InFrame) const;
+
+	void ResetFrames();
+};
@@ -0,0 +1,123 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "Misc/EnumClassFlags.h"
+#include "SimplePropertiesFwd.h"
+
+enum class ESimplePropertyHook : uint8
+{
+	None = 0,
+	Mirror = 1 << 0,
+	Journal = 1 << 1,
+	PushModel = 1 << 2,
+	Buffered = 1 << 3,
+	Await = 1 << 4
+};
+
+ENUM_CLASS_FLAGS(ESimplePropertyHook)
+
+/**
+ * The optional per-property features (mirroring, journaling, push model, buffering and awaiting) share one slot per
+ * property in a central table. A property with none of them attached only pays for a bit test in its change path.
+ * One with any attached makes a single out-of-line call, which hands each attached feature the data it stored in
+ * the slot, so no feature has to look the property up by its address.
+ *
+ * Slots are never moved once allocated, so a slot can be read from any thread that was given its index. Attaching
+ * and detaching take a lock and are done from the thread that sets the property.
+ *
+ * The slot records the property's address. A property must not be moved in memory (e.g. by a TArray growing) while
+ * it has hooks attached, which is checked whenever it changes. Copies and moves of a property don't take its hooks,
+ * and destroying a property detaches all of them.
+ */
+class SIMPLEPROPERTIES_API FSimplePropertyHooks
+{
+public:
+	struct FSlot
+	{
+		const void* Property = nullptr;
+		const void* Value = nullptr;
+		int32 ValueSize = 0;
+		ESimplePropertyHook Hooks = ESimplePropertyHook::None;
+
+		// The property's slot in the mirror segment.
+		int32 MirrorIndex = INDEX_NONE;
+
+		// The property's push-model entry.
+		int32 PushModelIndex = INDEX_NONE;
+
+		// The property's buffer entry.
+		int32 BufferIndex = INDEX_NONE;
+
+#if SIMPLE_PROPERTIES_WITH_COROUTINES
+		// The coroutines waiting on the property's next change, and the innermost change resuming them.
+		FSimplePropertyAwaitNode* AwaitList = nullptr;
+		FSimplePropertyAwaitResume* AwaitResume = nullptr;
+#endif
+
+		// Resets the property's hook state when its last hook is detached.
+		void (*ClearProperty)(void* InProperty) = nullptr;
+	};
+
+	/** Attaches a hook to the property, giving it a slot with its first one. */
+	template<typename InValueType, typename InPrivateType>
+	static FSlot& Attach(TSimpleConstProperty<InValueType, InPrivateType>& InProperty, ESimplePropertyHook InHook)
+	{
+		using FPropertyType = TSimpleConstProperty<InValueType, InPrivateType>;
+
+		if (!InProperty.bHasHooks)
+		{
+			InProperty.HookSlot = Acquire(&InProperty, &InProperty.Value, sizeof(InProperty.Value),
+				[](void* InHookedProperty)
+				{
+					FPropertyType& Property = *static_cast<FPropertyType*>(InHookedProperty);
+					Property.bHasHooks = false;
+					Property.HookSlot = INDEX_NONE;
+				});
+
+			InProperty.bHasHooks = true;
+		}
+
+		FSlot& Slot = GetSlot(InProperty.HookSlot);
+		Slot.Hooks |= InHook;
+		return Slot;
+	}
+
+	/** Detaches a hook from the property, releasing its slot with the last one. */
+	template<typename InValueType, typename InPrivateType>
+	static void Detach(TSimpleConstProperty<InValueType, InPrivateType>& InProperty, ESimplePropertyHook InHook)
+	{
+		if (InProperty.bHasHooks)
+		{
+			Detach(InProperty.HookSlot, InHook);
+		}
+	}
+
+	template<typename InValueType, typename InPrivateType>
+	static bool HasHook(const TSimpleConstProperty<InValueType, InPrivateType>& InProperty, ESimplePropertyHook InHook)
+	{
+		return InProperty.bHasHooks && EnumHasAnyFlags(GetSlot(InProperty.HookSlot).Hooks, InHook);
+	}
+
+	/** The slot of a property with hooks attached. */
+	template<typename InValueType, typename InPrivateType>
+	static FSlot& GetSlot(const TSimpleConstProperty<InValueType, InPrivateType>& InProperty)
+	{
+		check(InProperty.bHasHooks);
+		return GetSlot(InProperty.HookSlot);
+	}
+
+	static FSlot& GetSlot(int32 InSlotIndex);
+
+	/** Detaches a hook by slot, for features that only have the slot index. */
+	static void Detach(int32 InSlotIndex, ESimplePropertyHook InHook);
+
+	/** Called by the property when its value changes. Runs every attached hook. */
+	static void OnChanged(int32 InSlotIndex, const void* InProperty);
+
+	/** Called by the property when it's destroyed. Cancels its waiters and detaches every hook. */
+	static void OnDestroyed(int32 InSlotIndex, const void* InProperty);
+
+protected:
+	static int32 Acquire(const void* InProperty, const void* InValue, int32 InValueSize, void (*InClearProperty)(void*));
+};
@@ -0,0 +1,31 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+
+class FName;
+class FProperty;
+class UStruct;
+
+/**
+ * Resolved inner properties of reflected struct values, keyed by struct and property name, so repeated lookups
+ * from details panels and property paths are a hash probe rather than a walk of the property chain. Misses are
+ * cached too.
+ *
+ * Built lazily. Emptied after hot reload / reinstancing and after garbage collection, since either can free or
+ * replace the structs it points into.
+ */
+class SIMPLEPROPERTIES_API FSimplePropertyInnerPropertyCache
+{
+public:
+	/** Registers the invalidation hooks. Called by the module. */
+	static void Initialize();
+
+	static void Shutdown();
+
+	static bool FindInnerPropertyInstance(const UStruct* InStruct, const void* InValue, FName InPropertyName,
+		const FProperty*& OutProp, const void*& OutData);
+
+	static void Invalidate();
+};
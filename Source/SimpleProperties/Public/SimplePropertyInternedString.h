@@ -0,0 +1,184 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/StringView.h"
+#include "Containers/UnrealString.h"
+#include "SimplePropertyTypeTraits.h"
+#include <atomic>
+
+class FArchive;
+
+/**
+ * Handle to a string in a shared, thread-safe pool. Equal strings share one pool entry, so copies don't allocate and
+ * comparing two handles is a pointer compare. Entries are reference counted and freed when the last handle goes.
+ *
+ * Use it as the value type of a property (TSimpleProperty<FSimplePropertyInternedString>) for strings that repeat
+ * across many instances, such as faction names or state labels. Strings are matched case-sensitively.
+ *
+ * Names are already interned by the engine, use FName properties for those.
+ */
+class SIMPLEPROPERTIES_API FSimplePropertyInternedString
+{
+public:
+	FSimplePropertyInternedString() = default;
+
+	FSimplePropertyInternedString(FStringView InString)
+		: Entry(Intern(InString))
+	{
+	}
+
+	FSimplePropertyInternedString(const FString& InString)
+		: Entry(Intern(FStringView(InString)))
+	{
+	}
+
+	FSimplePropertyInternedString(const TCHAR* InString)
+		: Entry(Intern(FStringView(InString)))
+	{
+	}
+
+	FSimplePropertyInternedString(const FSimplePropertyInternedString& InOther)
+		: Entry(InOther.Entry)
+	{
+		AddRef(Entry);
+	}
+
+	FSimplePropertyInternedString(FSimplePropertyInternedString&& InOther)
+		: Entry(InOther.Entry)
+	{
+		InOther.Entry = nullptr;
+	}
+
+	~FSimplePropertyInternedString()
+	{
+		Release(Entry);
+	}
+
+	FSimplePropertyInternedString& operator=(const FSimplePropertyInternedString& InOther)
+	{
+		if (Entry != InOther.Entry)
+		{
+			AddRef(InOther.Entry);
+			Release(Entry);
+			Entry = InOther.Entry;
+		}
+
+		return *this;
+	}
+
+	FSimplePropertyInternedString& operator=(FSimplePropertyInternedString&& InOther)
+	{
+		if (this != &InOther)
+		{
+			Release(Entry);
+			Entry = InOther.Entry;
+			InOther.Entry = nullptr;
+		}
+
+		return *this;
+	}
+
+	const FString& Get() const
+	{
+		return Entry ? Entry->String : EmptyString;
+	}
+
+	operator const FString&() const
+	{
+		return Get();
+	}
+
+	bool IsEmpty() const
+	{
+		return Entry == nullptr;
+	}
+
+	bool operator==(const FSimplePropertyInternedString& InOther) const
+	{
+		return Entry == InOther.Entry;
+	}
+
+	friend uint32 GetTypeHash(const FSimplePropertyInternedString& InString)
+	{
+		return ::GetTypeHash(InString.Entry);
+	}
+
+	friend SIMPLEPROPERTIES_API FArchive& operator<<(FArchive& InArchive, FSimplePropertyInternedString& InString);
+
+	/** Number of distinct strings currently in the pool. */
+	static int32 GetNumInterned();
+
+protected:
+	friend class FSimplePropertyInternedStringPool;
+
+	struct FEntry
+	{
+		FString String;
+		std::atomic<int32> RefCount;
+	};
+
+	static const FString EmptyString;
+
+	// Null for the empty string, which is never pooled.
+	FEntry* Entry = nullptr;
+
+	/** Finds or adds the string and returns it with a reference added. */
+	static FEntry* Intern(FStringView InString);
+
+	static void AddRef(FEntry* InEntry)
+	{
+		if (InEntry)
+		{
+			InEntry->RefCount.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	static void Release(FEntry* InEntry);
+};
+
+struct FSimplePropertyInternedStringComparator
+{
+	template<typename InValueType, typename InCompareType>
+	static bool IsEqual(const InValueType& InValue, const InCompareType& InOther)
+	{
+		if constexpr (std::is_same_v<InCompareType, FSimplePropertyInternedString>)
+		{
+			return InValue == InOther;
+		}
+		else
+		{
+			// Comparing against a raw string doesn't need to touch the pool.
+			return FStringView(InValue.Get()).Equals(FStringView(InOther), ESearchCase::CaseSensitive);
+		}
+	}
+};
+
+// Only const access to the string, it has to be reassigned to change.
+template<>
+struct TSimplePropertyValueTypes<FSimplePropertyInternedString>
+{
+	using FValueType = FSimplePropertyInternedString;
+	using FReferenceType = const FString;
+	using FPointerType = const FString;
+
+	static const FReferenceType& GetReferenceValue(const FValueType& InValue)
+	{
+		return InValue.Get();
+	}
+
+	static const FPointerType* GetPointerValue(const FValueType& InValue)
+	{
+		return &InValue.Get();
+	}
+};
+
+template<>
+struct TSimplePropertyTypeTraits<FSimplePropertyInternedString>
+{
+	using FValueTypes = TSimplePropertyValueTypes<FSimplePropertyInternedString>;
+	using FComparatorType = FSimplePropertyInternedStringComparator;
+	using FReferenceCollectorType = TSimplePropertyReferenceCollector<FSimplePropertyInternedString>;
+	using FFindInnerPropertyType = TSimplePropertyInnerPropertyFinder<FSimplePropertyInternedString>;
+	using FTransactionObjectType = TSimplePropertyTransactionObject<FSimplePropertyInternedString>;
+};
@@ -0,0 +1,127 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "SimplePropertiesFwd.h"
+
+#if SIMPLE_PROPERTIES_WITH_JOURNAL
+
+#include "Containers/UnrealString.h"
+#include "SimplePropertyHooks.h"
+#include <type_traits>
+
+/**
+ * Journal file format. Native endian, records are packed and unaligned. Frames are counted from the frame the
+ * recording started on.
+ *
+ *	FFileHeader
+ *	{ ERecord::Declare, FDeclareRecord } | { ERecord::Change, FChangeRecord, uint8[ValueSize] } ...
+ *
+ * A declare maps a property address to the owner and property ids given to Track. Addresses can be reused after a
+ * property is untracked, so a change belongs to the latest declare of its address at or before its frame.
+ */
+namespace UE::SimpleProperties::Journal
+{
+	constexpr uint32 Magic = 0x524A5053; // "SPJR"
+	constexpr uint32 Version = 1;
+
+	enum class ERecord : uint8
+	{
+		Declare,
+		Change
+	};
+
+#pragma pack(push, 1)
+	struct FFileHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint64 StartFrame;
+	};
+
+	struct FDeclareRecord
+	{
+		uint64 Property;
+		uint32 Frame;
+		uint64 OwnerId;
+		uint32 PropertyId;
+		uint16 ValueSize;
+	};
+
+	struct FChangeRecord
+	{
+		uint64 Property;
+		uint32 Frame;
+		uint16 ValueSize;
+	};
+#pragma pack(pop)
+}
+
+/**
+ * Records the changes of tracked properties to an append-only file for deterministic replay
+ * (FSimplePropertyJournalReplay).
+ *
+ * The change path only copies the property address, frame and value bytes into a buffer owned by the calling thread.
+ * Full buffers are handed to a background thread that writes them out, so there's no lock, formatting or name lookup
+ * per change. The game thread's buffer is also flushed at the end of every frame. Other threads flush theirs when
+ * full, when they exit or with FlushThread.
+ *
+ * Owners are identified by an id the caller chooses (spawn index, net GUID...) so that replay can bind the changes
+ * to fresh owners. Only trivially copyable values are supported. Properties are untracked when they're destroyed.
+ *
+ * Stop() only flushes the calling thread. Records that another thread still holds in its buffer when the recording
+ * stops are lost, so threads that set tracked properties should call FlushThread once their work is done, before
+ * Stop is called. The game thread is flushed every frame.
+ *
+ * Compiled out when SIMPLE_PROPERTIES_WITH_JOURNAL is 0 (shipping by default).
+ */
+class SIMPLEPROPERTIES_API FSimplePropertyJournal
+{
+public:
+	/** Opens the file and starts recording. Tracked properties are declared with their current value. */
+	static bool Start(const FString& InPath);
+
+	/** Flushes the calling thread and stops the writer. Records still buffered by other threads are lost, see above. */
+	static void Stop();
+
+	static bool IsRecording();
+
+	template<typename InValueType, typename InPrivateType>
+	static void Track(uint64 InOwnerId, uint32 InPropertyId, TSimpleConstProperty<InValueType, InPrivateType>& InProperty)
+	{
+		using FValueType = typename TSimpleConstProperty<InValueType, InPrivateType>::FValueType;
+
+		static_assert(std::is_trivially_copyable_v<FValueType> && sizeof(FValueType) <= MAX_uint16,
+			"Only trivially copyable values can be journaled.");
+
+		const FSimplePropertyHooks::FSlot& Slot = FSimplePropertyHooks::Attach(InProperty, ESimplePropertyHook::Journal);
+		TrackInternal(InOwnerId, InPropertyId, &InProperty, Slot.Value, Slot.ValueSize);
+	}
+
+	template<typename InValueType, typename InPrivateType>
+	static void Untrack(TSimpleConstProperty<InValueType, InPrivateType>& InProperty)
+	{
+		if (FSimplePropertyHooks::HasHook(InProperty, ESimplePropertyHook::Journal))
+		{
+			UntrackInternal(&InProperty);
+			FSimplePropertyHooks::Detach(InProperty, ESimplePropertyHook::Journal);
+		}
+	}
+
+	/** Called by tracked properties when their value changes. */
+	static void Record(const void* InProperty, const void* InValue, int32 InValueSize);
+
+	/** Hands the calling thread's buffered records to the writer. */
+	static void FlushThread();
+
+	/** Stops recording. Called by the module. */
+	static void Shutdown();
+
+protected:
+	friend class FSimplePropertyHooks;
+
+	static void TrackInternal(uint64 InOwnerId, uint32 InPropertyId, const void* InProperty, const void* InValue, int32 InValueSize);
+	static void UntrackInternal(const void* InProperty);
+};
+
+#endif
@@ -0,0 +1,108 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "SimplePropertyJournal.h"
+
+#if SIMPLE_PROPERTIES_WITH_JOURNAL
+
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "SimplePropertyAccess.h"
+#include "Templates/Tuple.h"
+#include "Templates/UniquePtr.h"
+#include <type_traits>
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Plays a journal recorded by FSimplePropertyJournal back onto fresh owners. The file is memory mapped and indexed
+ * once on open; playback only copies value bytes.
+ *
+ * Bind each property to the owner and property ids it was tracked with, then call ReplayTo as frames advance. Changes
+ * are stored silently and fire the property's change event like a normal set. Changes for ids that aren't bound, or
+ * whose value size doesn't match, are skipped. Within a frame, changes made on one thread keep their order; the order
+ * between threads isn't recorded.
+ */
+class SIMPLEPROPERTIES_API FSimplePropertyJournalReplay
+{
+public:
+	FSimplePropertyJournalReplay();
+	~FSimplePropertyJournalReplay();
+
+	bool Open(const FString& InPath);
+	void Close();
+
+	template<typename InValueType, typename InPrivateType>
+	void Bind(uint64 InOwnerId, uint32 InPropertyId, TSimpleConstProperty<InValueType, InPrivateType>& InProperty)
+	{
+		using FPropertyType = TSimpleConstProperty<InValueType, InPrivateType>;
+		using FValueType = typename FPropertyType::FValueType;
+
+		static_assert(std::is_trivially_copyable_v<FValueType>, "Only trivially copyable values can be journaled.");
+
+		Bindings.Add({InOwnerId, InPropertyId}, {&InProperty, sizeof(FValueType),
+			[](void* InBoundProperty, const uint8* InValue)
+			{
+				FPropertyType& Property = *static_cast<FPropertyType*>(InBoundProperty);
+				alignas(FValueType) uint8 Storage[sizeof(FValueType)];
+				FMemory::Memcpy(Storage, InValue, sizeof(FValueType));
+
+				if (FSimplePropertyAccess::SetValueSilently(Property, *reinterpret_cast<const FValueType*>(Storage)))
+				{
+					FSimplePropertyAccess::NotifyChanged(Property);
+				}
+			}});
+	}
+
+	void Unbind(uint64 InOwnerId, uint32 InPropertyId)
+	{
+		Bindings.Remove({InOwnerId, InPropertyId});
+	}
+
+	/** Applies the changes recorded up to and including InFrame that haven't been applied yet. Returns how many were. */
+	int32 ReplayTo(uint32 InFrame);
+
+	/** The frame the last change was recorded on. */
+	uint32 GetLastFrame() const
+	{
+		return Changes.IsEmpty() ? 0 : Changes.Last().Frame;
+	}
+
+	bool IsFinished() const
+	{
+		return NextChange >= Changes.Num();
+	}
+
+protected:
+	using FBindingKey = TTuple<uint64, uint32>;
+	using FApplyFunction = void(*)(void* InProperty, const uint8* InValue);
+
+	struct FBinding
+	{
+		void* Property;
+		int32 ValueSize;
+		FApplyFunction Apply;
+	};
+
+	struct FChange
+	{
+		uint32 Frame;
+		int32 ValueSize;
+		FBindingKey Key;
+		const uint8* Value;
+	};
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TMap<FBindingKey, FBinding> Bindings;
+
+	// Sorted by frame.
+	TArray<FChange> Changes;
+	int32 NextChange = 0;
+
+	bool Index(const uint8* InData, int64 InSize);
+};
+
+#endif
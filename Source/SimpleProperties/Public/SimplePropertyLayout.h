@@ -0,0 +1,233 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/BitArray.h"
+#include "Math/MathFwd.h"
+#include "Serialization/Archive.h"
+#include "SimplePropertyAccess.h"
+#include "UObject/NameTypes.h"
+#include <type_traits>
+
+struct FSimplePropertySnapshot;
+
+/**
+ * Whether a value can be archived as raw bytes. Opt-in: only numbers, enums and the core math types are, as many
+ * trivially copyable types are only meaningful in the process that wrote them (FName indices, weak object pointers,
+ * object keys, handles) or have their own Serialize. Specialize to true for plain data structs that have neither.
+ */
+template<typename InValueType>
+struct TSimplePropertyIsBlockSerializable
+{
+	static constexpr bool Value = std::is_arithmetic_v<InValueType> || std::is_enum_v<InValueType>;
+};
+
+#define SIMPLE_PROPERTY_BLOCK_SERIALIZABLE_MATH_TYPE(Type) \
+	template<typename InScalarType> \
+	struct TSimplePropertyIsBlockSerializable<UE::Math::Type<InScalarType>> \
+	{ \
+		static constexpr bool Value = true; \
+	};
+
+SIMPLE_PROPERTY_BLOCK_SERIALIZABLE_MATH_TYPE(TVector)
+SIMPLE_PROPERTY_BLOCK_SERIALIZABLE_MATH_TYPE(TVector2)
+SIMPLE_PROPERTY_BLOCK_SERIALIZABLE_MATH_TYPE(TVector4)
+SIMPLE_PROPERTY_BLOCK_SERIALIZABLE_MATH_TYPE(TRotator)
+SIMPLE_PROPERTY_BLOCK_SERIALIZABLE_MATH_TYPE(TQuat)
+SIMPLE_PROPERTY_BLOCK_SERIALIZABLE_MATH_TYPE(TIntPoint)
+SIMPLE_PROPERTY_BLOCK_SERIALIZABLE_MATH_TYPE(TIntVector2)
+SIMPLE_PROPERTY_BLOCK_SERIALIZABLE_MATH_TYPE(TIntVector3)
+SIMPLE_PROPERTY_BLOCK_SERIALIZABLE_MATH_TYPE(TIntVector4)
+
+#undef SIMPLE_PROPERTY_BLOCK_SERIALIZABLE_MATH_TYPE
+
+template<>
+struct TSimplePropertyIsBlockSerializable<FLinearColor>
+{
+	static constexpr bool Value = true;
+};
+
+template<>
+struct TSimplePropertyIsBlockSerializable<FColor>
+{
+	static constexpr bool Value = true;
+};
+
+enum class ESimplePropertyLoadNotify : uint8
+{
+	// Fire the change event of every property that changed, once the whole owner has been loaded.
+	Fire,
+	// No change callbacks. Hooked properties (mirror, journal, push model, buffering, awaiting) are still compared
+	// and their hooks run if they changed; the rest are copied without being compared.
+	Suppress,
+	// No change callbacks, the changed entries are returned so the caller can notify once. Hooks still run.
+	Batch
+};
+
+struct FSimplePropertyLayoutEntry
+{
+	FName Name;
+
+	// Offsets within the owner
+	int32 PropertyOffset = 0;
+	int32 ValueOffset = 0;
+
+	// Trivially copyable values are memcpy'd into the snapshot's fixed block at SnapshotOffset.
+	// Everything else goes through the archive functions.
+	bool bTrivial = false;
+	int32 ValueSize = 0;
+	int32 SnapshotOffset = INDEX_NONE;
+
+	// Values that are still meaningful as raw bytes in another process are archived as one block.
+	bool bBlockSerializable = false;
+	int32 ArchiveBlockOffset = INDEX_NONE;
+
+	void (*SaveValue)(const void* InProperty, FArchive& InArchive) = nullptr;
+	bool (*LoadValue)(void* InProperty, FArchive& InArchive) = nullptr;
+
+	// Loads straight into the value, without comparing. For unhooked properties with ESimplePropertyLoadNotify::Suppress.
+	void (*StoreValue)(void* InProperty, FArchive& InArchive) = nullptr;
+	bool (*HasHooks)(const void* InProperty) = nullptr;
+
+	void (*NotifyCallback)(void* InProperty) = nullptr;
+	void (*NotifyHooks)(void* InProperty) = nullptr;
+};
+
+/**
+ * The set of properties on an owner type that take part in snapshots. Build one per owner type, e.g.
+ *
+ *	static const FSimplePropertyLayout Layout = FSimplePropertyLayout()
+ *		.Add(SIMPLE_PROPERTY_LAYOUT_MEMBER(AMyActor, Health))
+ *		.Add(SIMPLE_PROPERTY_LAYOUT_MEMBER(AMyActor, DisplayName));
+ *
+ * Offsets are taken with STRUCT_OFFSET, so owners are expected to be laid out without virtual bases.
+ */
+class SIMPLEPROPERTIES_API FSimplePropertyLayout
+{
+public:
+	/** The member pointer only supplies the types; InPropertyOffset is STRUCT_OFFSET(Owner, Member). */
+	template<typename InOwnerType, typename InPropertyType>
+	FSimplePropertyLayout& Add(FName InName, InPropertyType InOwnerType::* InMember, SIZE_T InPropertyOffset)
+	{
+		using FValueType = typename InPropertyType::FValueType;
+		using FConstPropertyType = TSimpleConstProperty<typename InPropertyType::FValueType, typename InPropertyType::FPrivateType>;
+
+		static_assert(std::is_base_of_v<FConstPropertyType, InPropertyType>);
+
+		FSimplePropertyLayoutEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.Name = InName;
+		Entry.PropertyOffset = static_cast<int32>(InPropertyOffset);
+		Entry.ValueOffset = FSimplePropertyAccess::GetValueOffset<InPropertyType>(InPropertyOffset);
+		Entry.bTrivial = std::is_trivially_copyable_v<FValueType>;
+		Entry.ValueSize = sizeof(FValueType);
+		Entry.bBlockSerializable = TSimplePropertyIsBlockSerializable<FValueType>::Value;
+
+		Entry.SaveValue = [](const void* InProperty, FArchive& InArchive)
+			{
+				const FConstPropertyType& Property = *static_cast<const FConstPropertyType*>(InProperty);
+				InArchive << const_cast<FValueType&>(FSimplePropertyAccess::GetValue(Property));
+			};
+
+		Entry.LoadValue = [](void* InProperty, FArchive& InArchive)
+			{
+				FValueType NewValue;
+				InArchive << NewValue;
+				return FSimplePropertyAccess::SetValueSilently(*static_cast<FConstPropertyType*>(InProperty), MoveTemp(NewValue));
+			};
+
+		Entry.StoreValue = [](void* InProperty, FArchive& InArchive)
+			{
+				InArchive << FSimplePropertyAccess::GetValue(*static_cast<FConstPropertyType*>(InProperty));
+			};
+
+		Entry.HasHooks = [](const void* InProperty)
+			{
+				return FSimplePropertyAccess::HasHooks(*static_cast<const FConstPropertyType*>(InProperty));
+			};
+
+		Entry.NotifyCallback = [](void* InProperty)
+			{
+				FSimplePropertyAccess::NotifyCallback(*static_cast<FConstPropertyType*>(InProperty));
+			};
+
+		Entry.NotifyHooks = [](void* InProperty)
+			{
+				FSimplePropertyAccess::NotifyHooks(*static_cast<FConstPropertyType*>(InProperty));
+			};
+
+		OnEntryAdded(Entry);
+
+		return *this;
+	}
+
+	const TArray<FSimplePropertyLayoutEntry>& GetEntries() const
+	{
+		return Entries;
+	}
+
+	/** Changes whenever entries are added, removed or resized. */
+	uint32 GetLayoutHash() const
+	{
+		return LayoutHash;
+	}
+
+	/** Captures every property in the layout. Game thread only; the result can be handed to another thread. */
+	void Capture(const void* InOwner, FSimplePropertySnapshot& OutSnapshot) const;
+
+	/**
+	 * Applies a snapshot without firing any per-property change callbacks. The hooks of the properties that changed
+	 * do run, once every value is in place, so mirrors, journals, push model and buffers don't go stale. Returns the
+	 * entries that changed so the caller can send a single notification for the whole restore (or call NotifyChanged).
+	 */
+	TBitArray<> Restore(void* InOwner, const FSimplePropertySnapshot& InSnapshot) const;
+
+	/** Fires the change callback of every entry flagged in InChanged. Their hooks already ran in Restore or Serialize. */
+	void NotifyChanged(void* InOwner, const TBitArray<>& InChanged) const;
+
+	/**
+	 * Saves or loads every property in the layout. Trivially copyable values are gathered into one block and
+	 * written with a single Serialize call instead of going through the archive per field.
+	 *
+	 * The entry names and sizes are saved with the data. On load, entries are matched by name; saved entries that
+	 * no longer exist or changed size are skipped and current entries missing from the data keep their value, so
+	 * adding, removing or reordering properties doesn't break old data.
+	 *
+	 * The archive is only read or written forwards, so it works with archives that can't seek (network and
+	 * compressed streams). Values that aren't in the block are serialized through a memory archive that writes
+	 * names and object references as strings, and are prefixed with their size so unknown ones can be skipped.
+	 *
+	 * Only the current archive version is accepted. Sizes read from the archive are checked against what's left of
+	 * it, so a truncated or hostile archive sets the error flag instead of allocating or reading past the end.
+	 *
+	 * Returns the entries that changed on load (empty with Suppress, or when saving).
+	 */
+	TBitArray<> Serialize(FArchive& InArchive, void* InOwner, ESimplePropertyLoadNotify InNotify = ESimplePropertyLoadNotify::Fire) const;
+
+protected:
+	TArray<FSimplePropertyLayoutEntry> Entries;
+	int32 TrivialBytes = 0;
+	int32 ArchiveBlockBytes = 0;
+	uint32 LayoutHash = 0;
+
+	void OnEntryAdded(FSimplePropertyLayoutEntry& InEntry);
+
+	void Save(FArchive& InArchive, const uint8* InOwner) const;
+	TBitArray<> Load(FArchive& InArchive, uint8* InOwner, ESimplePropertyLoadNotify InNotify) const;
+
+	// Runs the hooks of every entry flagged in InChanged, after its callback if bInCallbacks.
+	void DispatchChanged(uint8* InOwner, const TBitArray<>& InChanged, bool bInCallbacks) const;
+};
+
+// The arguments of FSimplePropertyLayout::Add for a member, named after the member.
+#define SIMPLE_PROPERTY_LAYOUT_MEMBER(Class, Member) TEXT(#Member), &Class::Member, STRUCT_OFFSET(Class, Member)
+
+/**
+ * Property values of one owner. Trivially copyable values are stored as a contiguous block at the start of
+ * Data, followed by the archive-serialized ones. Plain data, so it's safe to compress or write out on a worker.
+ */
+struct FSimplePropertySnapshot
+{
+	TArray<uint8> Data;
+	uint32 LayoutHash = 0;
+};
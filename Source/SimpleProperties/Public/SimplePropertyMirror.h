@@ -0,0 +1,123 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "SimplePropertiesFwd.h"
+
+#if SIMPLE_PROPERTIES_WITH_MIRROR
+
+#include "SimplePropertyCallback.h"
+#include "SimplePropertyHooks.h"
+#include "UObject/NameTypes.h"
+#include <atomic>
+#include <type_traits>
+
+/**
+ * Segment layout of the property mirror. Stable and self-describing so that an external tool can map the segment
+ * (named "SimplePropertiesMirror_<ProcessId>") and read it without linking against the engine, as
+ * Extras/SimplePropertiesMirrorReader does. Bump Version when changing it, and update the reader.
+ *
+ * Each slot is a seqlock: the writer makes Sequence odd, writes, then makes it even again. Readers copy the slot
+ * and retry if Sequence was odd or changed while copying. The writer never waits for readers.
+ */
+namespace UE::SimpleProperties::Mirror
+{
+	constexpr uint32 Magic = 0x524D5053; // "SPMR"
+	constexpr uint32 Version = 2;
+	constexpr int32 MaxSlots = 1024;
+	constexpr int32 NameLength = 64;
+	constexpr int32 TypeLength = 64;
+	constexpr int32 ValueBytes = 64;
+
+	struct FSlot
+	{
+		std::atomic<uint32> Sequence;
+		uint32 ValueSize;
+		uint64 Generation;
+		ANSICHAR Name[NameLength];
+		ANSICHAR Type[TypeLength];
+		uint8 Value[ValueBytes];
+	};
+
+	struct FHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint32 MaxSlots;
+		uint32 SlotSize;
+		std::atomic<uint32> NumSlots;
+
+		// From the start of the segment, aligned for FSlot.
+		uint32 SlotsOffset;
+	};
+
+	constexpr uint32 SlotsOffset = (sizeof(FHeader) + alignof(FSlot) - 1) / alignof(FSlot) * alignof(FSlot);
+
+	static_assert(std::atomic<uint32>::is_always_lock_free, "The mirror needs lock-free atomics to be shared between processes.");
+}
+
+/**
+ * Opt-in live mirror of property values in a local shared memory segment, for external inspection without a
+ * debugger. Only registered properties are mirrored; they publish from their change path. Everything else pays
+ * nothing beyond a bit test.
+ *
+ * Only trivially copyable values of up to Mirror::ValueBytes are supported. Properties are unregistered when
+ * they're destroyed. Compiled out when SIMPLE_PROPERTIES_WITH_MIRROR is 0 (shipping by default).
+ *
+ * On Windows the segment is a Global\ file mapping, which the game can only create with SeCreateGlobalPrivilege
+ * (administrators and services have it). Without it registering fails and a warning is logged.
+ */
+class SIMPLEPROPERTIES_API FSimplePropertyMirror
+{
+public:
+	template<typename InValueType, typename InPrivateType>
+	static bool Register(const FName& InName, TSimpleConstProperty<InValueType, InPrivateType>& InProperty)
+	{
+		using FValueType = typename TSimpleConstProperty<InValueType, InPrivateType>::FValueType;
+
+		static_assert(std::is_trivially_copyable_v<FValueType> && sizeof(FValueType) <= UE::SimpleProperties::Mirror::ValueBytes,
+			"Only trivially copyable values that fit in a mirror slot can be mirrored.");
+
+		if (FSimplePropertyHooks::HasHook(InProperty, ESimplePropertyHook::Mirror))
+		{
+			return false;
+		}
+
+		FSimplePropertyHooks::FSlot& Slot = FSimplePropertyHooks::Attach(InProperty, ESimplePropertyHook::Mirror);
+		Slot.MirrorIndex = RegisterInternal(InName, UE::SimpleProperties::Private::GetTypeName<FValueType>(), Slot.Value,
+			Slot.ValueSize);
+
+		if (Slot.MirrorIndex == INDEX_NONE)
+		{
+			FSimplePropertyHooks::Detach(InProperty, ESimplePropertyHook::Mirror);
+			return false;
+		}
+
+		return true;
+	}
+
+	template<typename InValueType, typename InPrivateType>
+	static void Unregister(TSimpleConstProperty<InValueType, InPrivateType>& InProperty)
+	{
+		if (FSimplePropertyHooks::HasHook(InProperty, ESimplePropertyHook::Mirror))
+		{
+			UnregisterInternal(FSimplePropertyHooks::GetSlot(InProperty).MirrorIndex);
+			FSimplePropertyHooks::Detach(InProperty, ESimplePropertyHook::Mirror);
+		}
+	}
+
+	/** Called by mirrored properties when their value changes, with the slot returned by registration. No lock. */
+	static void Publish(int32 InMirrorIndex, const void* InValue, int32 InValueSize);
+
+	/** Unmaps the segment. Called by the module. */
+	static void Shutdown();
+
+protected:
+	friend class FSimplePropertyHooks;
+
+	/** Returns the mirror slot, or INDEX_NONE. */
+	static int32 RegisterInternal(const FName& InName, const ANSICHAR* InTypeName, const void* InValue, int32 InValueSize);
+	static void UnregisterInternal(int32 InMirrorIndex);
+};
+
+#endif
@@ -0,0 +1,97 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "SimplePropertyInnerPropertyCache.h"
+#include "SimplePropertyTypeTraits.h"
+#include "Templates/Requires.h"
+#include "Templates/UnrealTypeTraits.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/Object.h"
+#include "UObject/ObjectPtr.h"
+
+// GC and inner property traits. These need the UObject headers, so they are kept out of SimpleProperty.h.
+// Include this where AddStructReferencedObjects or FindInnerPropertyInstance are used (SimplePropertyStructOps.h
+// does so for you). The transaction trait is in SimplePropertyTransactionManager.h.
+
+template<typename InValueType>
+struct TSimplePropertyReferenceCollector
+{
+	enum
+	{
+		Struct = TModels<CCanCollectReferences, InValueType>::Value,
+		Object = TIsDerivedFrom<typename TRemovePointer<InValueType>::Type, UObject>::Value,
+		Value = Struct || Object
+	};
+
+	template<typename InCollectValueType
+		UE_REQUIRES(Struct)>
+	static bool AddReferences(const InCollectValueType& InValue, FReferenceCollector& InCollector)
+	{
+		return InValue.AddStructReferencedObjects(InCollector);
+	}
+
+	template<typename InCollectValueType
+		UE_REQUIRES(Object)>
+	static bool AddReferences(const InCollectValueType& InValue, FReferenceCollector& InCollector)
+	{
+		UObject* Value = InValue;
+
+		if (IsValid(Value))
+		{
+			PRAGMA_DISABLE_DEPRECATION_WARNINGS
+			InCollector.AddReferencedObject(Value);
+			PRAGMA_ENABLE_DEPRECATION_WARNINGS
+
+			return true;
+		}
+
+		return false;
+	}
+};
+
+// Values with their own FindInnerPropertyInstance (e.g. instanced structs) are asked directly. Plain USTRUCT values
+// are resolved through FSimplePropertyInnerPropertyCache.
+template<typename InValueType>
+struct TSimplePropertyInnerPropertyFinder
+{
+	enum
+	{
+		Own = TModels<CCanFindInnerPropertyInstance, InValueType>::Value,
+		Struct = TModels<CHasStaticStruct, InValueType>::Value,
+		Value = Own || Struct
+	};
+
+	template<typename InFindValueType
+		UE_REQUIRES(Own)>
+	static bool FindInnerPropertyInstance(const InFindValueType& InValue, FName InPropertyName, const FProperty*& OutProp, const void*& OutData)
+	{
+		return InValue.FindInnerPropertyInstance(InPropertyName, OutProp, OutData);
+	}
+
+	template<typename InFindValueType
+		UE_REQUIRES(!Own && Struct)>
+	static bool FindInnerPropertyInstance(const InFindValueType& InValue, FName InPropertyName, const FProperty*& OutProp, const void*& OutData)
+	{
+		return FSimplePropertyInnerPropertyCache::FindInnerPropertyInstance(InFindValueType::StaticStruct(), &InValue,
+			InPropertyName, OutProp, OutData);
+	}
+};
+
+template<typename InValueType>
+struct TSimplePropertyReferenceCollector<TObjectPtr<InValueType>>
+{
+	using FValueType = TObjectPtr<InValueType>;
+
+	static bool AddReferences(const FValueType& InValue, FReferenceCollector& InCollector)
+	{
+		if (IsValid(InValue.Get()))
+		{
+			FValueType ObjectPtr = InValue;
+			InCollector.AddReferencedObject(ObjectPtr);
+			return true;
+		}
+
+		return false;
+	}
+};
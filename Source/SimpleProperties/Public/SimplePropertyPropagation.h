@@ -0,0 +1,73 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "SimplePropertiesFwd.h"
+#include "Templates/UniquePtr.h"
+#include "Templates/UnrealTemplate.h"
+#include <type_traits>
+
+/**
+ * Tracks the properties whose change callbacks are currently running on this thread (the "change wave").
+ *
+ * A callback may set its own property directly (e.g. to clamp the value), which recurses like any other set, up to
+ * SimpleProperties.MaxSelfReentryDepth nested calls. Otherwise, if a callback sets a property whose callback is
+ * already on the stack, the set is deferred until the outermost callback returns instead of recursing. Deferred sets
+ * are coalesced per property and drained for at most SimpleProperties.MaxPropagationIterations passes; anything
+ * still ping-ponging after that is dropped and logged along with the chain of callbacks it re-entered. A deferred
+ * set returns false, as the value hasn't changed yet.
+ *
+ * Deferred sets capture the property. A property that deferred one calls Forget when it's destroyed, which drops
+ * its pending sets on this thread.
+ */
+class SIMPLEPROPERTIES_API FSimplePropertyPropagation
+{
+public:
+	struct FDeferredSet
+	{
+		virtual ~FDeferredSet() = default;
+		virtual void Apply() = 0;
+	};
+
+	/** Registers the end-of-frame diagnostics. Called by the module. */
+	static void Initialize();
+
+	static void Shutdown();
+
+	/**
+	 * Called before firing a property's callback. Returns false if the property is already in the current wave,
+	 * in which case the caller must Defer the set rather than applying it.
+	 */
+	static bool Enter(const void* InProperty, const TSimplePropertyCallback<void()>& InCallback);
+
+	/** Called after the callback returns. Drains the deferred sets when the outermost callback finishes. */
+	static void Exit();
+
+	/** Drops the deferred sets of a property that is being destroyed. */
+	static void Forget(const void* InProperty);
+
+	template<typename InFunctionType>
+	static void Defer(const void* InProperty, const TSimplePropertyCallback<void()>& InCallback, InFunctionType&& InApply)
+	{
+		struct TDeferredSet : public FDeferredSet
+		{
+			std::decay_t<InFunctionType> Function;
+
+			TDeferredSet(InFunctionType&& InFunction)
+				: Function(Forward<InFunctionType>(InFunction))
+			{
+			}
+
+			virtual void Apply() override
+			{
+				Function();
+			}
+		};
+
+		DeferInternal(InProperty, InCallback, MakeUnique<TDeferredSet>(Forward<InFunctionType>(InApply)));
+	}
+
+protected:
+	static void DeferInternal(const void* InProperty, const TSimplePropertyCallback<void()>& InCallback,
+		TUniquePtr<FDeferredSet> InSet);
+};
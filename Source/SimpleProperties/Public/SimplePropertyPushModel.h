@@ -0,0 +1,82 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "SimplePropertiesFwd.h"
+
+#if SIMPLE_PROPERTIES_WITH_PUSH_MODEL
+
+#include "SimplePropertyHooks.h"
+#include "UObject/NameTypes.h"
+
+class UObject;
+
+/**
+ * Push-model replication for properties that are replicated members of their owner. A registered property marks
+ * its replicated field dirty whenever its value changes, so the net driver doesn't have to compare it every update.
+ * Mark the field push based when registering it for replication:
+ *
+ *	FDoRepLifetimeParams Params;
+ *	Params.bIsPushBased = true;
+ *	DOREPLIFETIME_WITH_PARAMS_FAST(AMyActor, Health, Params);
+ *
+ * and register the property once the owner is constructed:
+ *
+ *	SIMPLE_PROPERTY_PUSH_MODEL(AMyActor, Health);
+ *
+ * The rep index is looked up once, here, into an entry whose index is kept in the property's hook slot; a change
+ * marks the field dirty straight from it. Properties are unregistered when they're destroyed, and entries whose
+ * owner was collected first stop marking anything. Game thread only, as the push model itself is.
+ */
+class SIMPLEPROPERTIES_API FSimplePropertyPushModel
+{
+public:
+	/** Returns false if InPropertyName isn't a replicated property of the owner's class. */
+	template<typename InValueType, typename InPrivateType>
+	static bool Register(UObject* InOwner, FName InPropertyName, TSimpleConstProperty<InValueType, InPrivateType>& InProperty)
+	{
+		if (FSimplePropertyHooks::HasHook(InProperty, ESimplePropertyHook::PushModel))
+		{
+			Unregister(InProperty);
+		}
+
+		const int32 PushModelIndex = RegisterInternal(InOwner, InPropertyName);
+
+		if (PushModelIndex == INDEX_NONE)
+		{
+			return false;
+		}
+
+		FSimplePropertyHooks::Attach(InProperty, ESimplePropertyHook::PushModel).PushModelIndex = PushModelIndex;
+		return true;
+	}
+
+	template<typename InValueType, typename InPrivateType>
+	static void Unregister(TSimpleConstProperty<InValueType, InPrivateType>& InProperty)
+	{
+		if (FSimplePropertyHooks::HasHook(InProperty, ESimplePropertyHook::PushModel))
+		{
+			UnregisterInternal(FSimplePropertyHooks::GetSlot(InProperty).PushModelIndex);
+			FSimplePropertyHooks::Detach(InProperty, ESimplePropertyHook::PushModel);
+		}
+	}
+
+	/** Called by registered properties when their value changes, with the index returned by registration. */
+	static void MarkDirty(int32 InPushModelIndex);
+
+	/** Called by the module. */
+	static void Initialize();
+	static void Shutdown();
+
+protected:
+	friend class FSimplePropertyHooks;
+
+	/** Returns the entry's index, or INDEX_NONE. */
+	static int32 RegisterInternal(UObject* InOwner, FName InPropertyName);
+	static void UnregisterInternal(int32 InPushModelIndex);
+};
+
+// Registers a property of this object, which must be an instance of Class.
+#define SIMPLE_PROPERTY_PUSH_MODEL(Class, Member) FSimplePropertyPushModel::Register(this, GET_MEMBER_NAME_CHECKED(Class, Member), Member)
+
+#endif
@@ -0,0 +1,190 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "SimplePropertyCallback.h"
+#include "SimplePropertyTypeTraits.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/SoftObjectPtr.h"
+
+struct FStreamableHandle;
+
+enum class ESimplePropertySoftLoad : uint8
+{
+	// Fire the change event straight away, whether or not the asset is loaded.
+	None,
+	// Stream the asset in and fire the change event once it's resident.
+	Async
+};
+
+/** Async loading for TSimpleSoftProperty. Loads are streamed on the game thread's streamable manager. */
+class SIMPLEPROPERTIES_API FSimplePropertySoftLoader
+{
+public:
+	using FOnLoaded = TSimplePropertyCallback<void()>;
+
+	/**
+	 * Starts streaming InPath in. InOnLoaded runs on the game thread once the load completes, which may be before
+	 * this returns if the asset is already loaded. The handle keeps the asset resident until it's released.
+	 */
+	static TSharedPtr<FStreamableHandle> Request(const FSoftObjectPath& InPath, FOnLoaded InOnLoaded);
+
+	/** Cancels the load if it's still in flight, otherwise lets the asset go. Resets the handle. */
+	static void Release(TSharedPtr<FStreamableHandle>& InOutHandle);
+
+	/** Releases the streamable manager. Called by the module. */
+	static void Shutdown();
+};
+
+/**
+ * Soft object or class pointer property (InSoftPtrType is a TSoftObjectPtr or TSoftClassPtr) that streams its asset
+ * in when it's set, instead of the change callback having to load it synchronously.
+ *
+ * With ESimplePropertySoftLoad::Async the change event fires once, when the asset is resident (or failed to load).
+ * Setting the path it's already loading does nothing, and setting a different path cancels the pending load, so
+ * only the last path set fires. The loaded asset is kept resident while the property points at it.
+ *
+ * The load callback refers to the property, so it can't be copied or moved. It only does so through a weak token
+ * that the property owns, so a completion that was already queued when the property was destroyed does nothing.
+ */
+template<typename InSoftPtrType>
+struct TSimpleSoftProperty
+{
+	using FValueType = InSoftPtrType;
+	using FOnCallback = TSimplePropertyCallback<void()>;
+	using FPointerType = typename TSimplePropertyValueTypes<FValueType>::FPointerType;
+
+	TSimpleSoftProperty() = default;
+
+	explicit TSimpleSoftProperty(FOnCallback InCallback)
+		: OnChangeCallback(MoveTemp(InCallback))
+	{
+	}
+
+	// The default is stored as is, nothing is loaded.
+	explicit TSimpleSoftProperty(const FValueType& InDefault, FOnCallback InCallback = FOnCallback())
+		: Value(InDefault)
+		, OnChangeCallback(MoveTemp(InCallback))
+	{
+	}
+
+	TSimpleSoftProperty(const TSimpleSoftProperty&) = delete;
+	TSimpleSoftProperty& operator=(const TSimpleSoftProperty&) = delete;
+
+	~TSimpleSoftProperty()
+	{
+		FSimplePropertySoftLoader::Release(Handle);
+	}
+
+	const FValueType& Get() const
+	{
+		return Value;
+	}
+
+	operator const FValueType&() const
+	{
+		return Value;
+	}
+
+	/** The asset, if it's loaded and not still streaming. Never loads. */
+	FPointerType* GetResident() const
+	{
+		return bLoading ? nullptr : Value.Get();
+	}
+
+	bool IsLoading() const
+	{
+		return bLoading;
+	}
+
+	/** Returns true if the path changed. */
+	bool Set(const FValueType& InValue, ESimplePropertySoftLoad InLoad = ESimplePropertySoftLoad::Async)
+	{
+		if (Value == InValue)
+		{
+			return false;
+		}
+
+		Value = InValue;
+
+		// Supersedes a pending load, or lets the previous asset go.
+		FSimplePropertySoftLoader::Release(Handle);
+
+		if (!Serial.IsValid())
+		{
+			Serial = MakeShared<uint32>(0);
+		}
+
+		const uint32 RequestSerial = ++*Serial;
+
+		if (InLoad == ESimplePropertySoftLoad::None || Value.IsNull())
+		{
+			bLoading = false;
+			OnChangeCallback.ExecuteIfBound();
+			return true;
+		}
+
+		// The request may complete before it returns.
+		bLoading = true;
+
+		TSharedPtr<FStreamableHandle> NewHandle = FSimplePropertySoftLoader::Request(Value.ToSoftObjectPath(),
+			FSimplePropertySoftLoader::FOnLoaded::CreateLambda([this, WeakSerial = TWeakPtr<uint32>(Serial), RequestSerial]()
+				{
+					// Gone with the property, which may have been destroyed while the completion was queued.
+					if (WeakSerial.IsValid())
+					{
+						OnLoaded(RequestSerial);
+					}
+				}));
+
+		// A change callback run by an immediate completion may have set a newer path already.
+		if (RequestSerial != *Serial)
+		{
+			FSimplePropertySoftLoader::Release(NewHandle);
+			return true;
+		}
+
+		Handle = MoveTemp(NewHandle);
+
+		// No handle means nothing was requested (e.g. an invalid path) and the completion will never come.
+		if (!Handle && bLoading)
+		{
+			OnLoaded(RequestSerial);
+		}
+
+		return true;
+	}
+
+	TSimpleSoftProperty& operator=(const FValueType& InValue)
+	{
+		Set(InValue);
+		return *this;
+	}
+
+	void SetOnChange(FOnCallback InCallback)
+	{
+		OnChangeCallback = MoveTemp(InCallback);
+	}
+
+protected:
+	FValueType Value;
+	TSharedPtr<FStreamableHandle> Handle;
+	FOnCallback OnChangeCallback;
+
+	// Identifies the latest request, so a completion that was already queued when it was superseded is ignored.
+	// Shared so completions can tell the property is gone; allocated by the first set.
+	TSharedPtr<uint32> Serial;
+	bool bLoading = false;
+
+	void OnLoaded(uint32 InSerial)
+	{
+		if (InSerial != *Serial)
+		{
+			return;
+		}
+
+		bLoading = false;
+		OnChangeCallback.ExecuteIfBound();
+	}
+};
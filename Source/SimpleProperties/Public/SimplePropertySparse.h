@@ -0,0 +1,232 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "Misc/Optional.h"
+#include "SimplePropertyCallback.h"
+#include "SimplePropertyTypeTraits.h"
+#include "Templates/UnrealTemplate.h"
+
+/**
+ * Property that reads from a shared default until it is first given a different value. Only then is the value
+ * allocated, per instance, so a property left at its default costs one pointer. Meant for large values (strings,
+ * text, structs) - small values are cheaper stored inline with TSimpleProperty.
+ *
+ * The change callback lives in the same heap record as the override, so binding one allocates the record even while
+ * the property is at its default. Properties that are mostly left alone and have no callback stay a single pointer.
+ *
+ * The default is referenced, not copied, and must outlive every property using it - typically a static or a
+ * value on the class default object. Setting the property back to its default (or calling ResetToDefault)
+ * frees the override.
+ *
+ * The callback runs directly from Set, outside FSimplePropertyPropagation's re-entrancy guard, and sparse
+ * properties can't have transactions or hooks; use TSimpleProperty where those are needed.
+ */
+template<typename InValueType>
+struct TSimpleSparseProperty
+{
+	using FValueType = InValueType;
+	using FOnCallback = TSimplePropertyCallback<void()>;
+	using FComparatorType = TSimplePropertyTypeTraits<FValueType>::template FComparatorType;
+
+	explicit TSimpleSparseProperty(const FValueType& InDefault)
+		: Data(reinterpret_cast<UPTRINT>(&InDefault))
+	{
+	}
+
+	TSimpleSparseProperty(const FValueType& InDefault, FOnCallback InCallback)
+		: Data(reinterpret_cast<UPTRINT>(&InDefault))
+	{
+		SetOnChange(MoveTemp(InCallback));
+	}
+
+	TSimpleSparseProperty(const TSimpleSparseProperty& InOther)
+		: Data(reinterpret_cast<UPTRINT>(&InOther.GetDefault()))
+	{
+		if (InOther.HasRecord())
+		{
+			SetRecord(new FRecord(*InOther.GetRecord()));
+		}
+	}
+
+	TSimpleSparseProperty(TSimpleSparseProperty&& InOther)
+		: Data(InOther.Data)
+	{
+		InOther.Data = reinterpret_cast<UPTRINT>(&GetDefault());
+	}
+
+	~TSimpleSparseProperty()
+	{
+		if (HasRecord())
+		{
+			delete GetRecord();
+		}
+	}
+
+	// Assignment copies the value (not the default or callback) and fires the change event like Set does.
+	TSimpleSparseProperty& operator=(const TSimpleSparseProperty& InOther)
+	{
+		Set(InOther.Get());
+		return *this;
+	}
+
+	template<typename InAssignType>
+	TSimpleSparseProperty& operator=(InAssignType&& InValue)
+	{
+		Set(Forward<InAssignType>(InValue));
+		return *this;
+	}
+
+	const FValueType& Get() const
+	{
+		return IsOverridden() ? GetRecord()->Override.GetValue() : GetDefault();
+	}
+
+	operator const FValueType&() const
+	{
+		return Get();
+	}
+
+	const FValueType& operator*() const
+	{
+		return Get();
+	}
+
+	const FValueType* operator->() const
+	{
+		return &Get();
+	}
+
+	const FValueType& GetDefault() const
+	{
+		return HasRecord() ? *GetRecord()->Default : *reinterpret_cast<const FValueType*>(Data);
+	}
+
+	bool IsOverridden() const
+	{
+		return HasRecord() && GetRecord()->Override.IsSet();
+	}
+
+	/** Returns true if the value changed. Setting the default value frees the override. */
+	template<typename InAssignType>
+	bool Set(InAssignType&& InValue)
+	{
+		if (FComparatorType::template IsEqual<FValueType>(Get(), InValue))
+		{
+			return false;
+		}
+
+		if (FComparatorType::template IsEqual<FValueType>(GetDefault(), InValue))
+		{
+			ClearOverride();
+		}
+		else if (IsOverridden())
+		{
+			GetRecord()->Override.GetValue() = Forward<InAssignType>(InValue);
+		}
+		else
+		{
+			FindOrAddRecord().Override.Emplace(Forward<InAssignType>(InValue));
+		}
+
+		OnChange();
+		return true;
+	}
+
+	/** Drops the override, if any, and reads from the default again. Returns true if the value changed. */
+	bool ResetToDefault()
+	{
+		if (!IsOverridden())
+		{
+			return false;
+		}
+
+		// Set never leaves an override equal to the default, so this is always a change.
+		ClearOverride();
+		OnChange();
+		return true;
+	}
+
+	void SetOnChange(FOnCallback InCallback)
+	{
+		if (InCallback.IsBound())
+		{
+			FindOrAddRecord().OnChangeCallback = MoveTemp(InCallback);
+		}
+		else if (HasRecord())
+		{
+			GetRecord()->OnChangeCallback = FOnCallback();
+			FreeRecordIfUnused();
+		}
+	}
+
+protected:
+	// Everything beyond the default. The record keeps the default pointer so that the property itself only needs one pointer.
+	struct FRecord
+	{
+		const FValueType* Default;
+		FOnCallback OnChangeCallback;
+		TOptional<FValueType> Override;
+	};
+
+	static constexpr UPTRINT RecordFlag = 1;
+
+	// Both pointers need a free low bit.
+	static_assert(alignof(FValueType) >= 2, "Sparse properties need values aligned to at least 2 bytes.");
+
+	// The default (untagged) or an owned FRecord tagged with RecordFlag.
+	UPTRINT Data;
+
+	bool HasRecord() const
+	{
+		return (Data & RecordFlag) != 0;
+	}
+
+	FRecord* GetRecord() const
+	{
+		return reinterpret_cast<FRecord*>(Data & ~RecordFlag);
+	}
+
+	void SetRecord(FRecord* InRecord)
+	{
+		Data = reinterpret_cast<UPTRINT>(InRecord) | RecordFlag;
+	}
+
+	FRecord& FindOrAddRecord()
+	{
+		if (!HasRecord())
+		{
+			SetRecord(new FRecord{&GetDefault()});
+		}
+
+		return *GetRecord();
+	}
+
+	void ClearOverride()
+	{
+		if (HasRecord())
+		{
+			GetRecord()->Override.Reset();
+			FreeRecordIfUnused();
+		}
+	}
+
+	void FreeRecordIfUnused()
+	{
+		FRecord* Record = GetRecord();
+
+		if (!Record->Override.IsSet() && !Record->OnChangeCallback.IsBound())
+		{
+			Data = reinterpret_cast<UPTRINT>(Record->Default);
+			delete Record;
+		}
+	}
+
+	void OnChange()
+	{
+		if (HasRecord())
+		{
+			GetRecord()->OnChangeCallback.ExecuteIfBound();
+		}
+	}
+};
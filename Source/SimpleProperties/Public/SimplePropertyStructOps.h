@@ -0,0 +1,22 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "SimpleProperty.h"
+#include "SimplePropertyObjectTraits.h"
+#include "UObject/Class.h"
+
+// Struct ops for exposing properties to reflected structs. Pulls in UObject/Class.h, so only include it
+// where the struct ops are needed.
+template<typename InValueType>
+struct TStructOpsTypeTraits<TSimplePropertyBase<InValueType>>
+	: public TStructOpsTypeTraitsBase2<TSimplePropertyBase<InValueType>>
+{
+	enum
+	{
+		WithCopy = true,
+		WithIdenticalViaEquality = true,
+		WithAddStructReferencedObjects = TSimplePropertyTypeTraits<InValueType>::FReferenceCollectorType::Value,
+		WithFindInnerPropertyInstance = TSimplePropertyTypeTraits<InValueType>::FFindInnerPropertyType::Value
+	};
+};
@@ -2,8 +2,6 @@
 
 #pragma once
 
-#include "Templates/SharedPointer.h"
-
 // TIsFunction doesn't work for static class functions
 template<typename InType>
 struct TIsStaticClassFunction
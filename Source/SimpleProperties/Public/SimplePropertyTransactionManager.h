@@ -0,0 +1,196 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#if WITH_EDITOR
+
+#include "CoreTypes.h"
+#include "Templates/SharedPointerFwd.h"
+#include <type_traits>
+
+class FScopedTransaction;
+class FText;
+class UObject;
+
+template<typename T>
+struct TObjectPtr;
+
+enum class ESimplePropertyTransactionEndResult : uint8
+{
+	Cancelled,
+	Ended,
+	Invalid,
+	NotManaged,
+	NotUnmanaged,
+	UnknownError,
+	FirstError = Invalid
+};
+
+/**
+ * How to copy a property's value and set it back, without knowing its type. Each property type supplies one, so
+ * undo can be recorded from the transaction code without it being compiled per value type.
+ */
+struct FSimplePropertyUndoValueOps
+{
+	SIZE_T Size;
+	SIZE_T Alignment;
+	const void* (*GetValue)(const void* InProperty);
+	void (*SetValue)(void* InProperty, const void* InValue);
+	void (*CopyValue)(void* InDestination, const void* InSource);
+	void (*DestroyValue)(void* InValue);
+};
+
+class SIMPLEPROPERTIES_API FSimplePropertyTransactionManager
+{
+public:
+	static FSimplePropertyTransactionManager& Get();
+
+	static int32 GetInvalidTransactionId();
+
+	static bool IsValidTransactionId(int32 InTransactionId);
+
+	/** The object if it's valid, so transaction traits don't need the UObject headers. */
+	static UObject* GetValidObject(const UObject* InObject);
+
+	UE_NODISCARD static int32 StartUnmanagedTransaction(const FText& InTransactionDescription, UObject* InPrimaryObject = nullptr);
+
+	UE_NODISCARD static TSharedPtr<FScopedTransaction> StartUnmanagedScopedTransaction(const FText& InTransactionDescription,
+		UObject* InPrimaryObject = nullptr);
+
+	bool IsManagedTransaction(int32 InTransactionId) const;
+
+	bool IsUnmanagedTransaction(int32 InTransactionId) const;
+
+	bool HasManagedTransaction() const;
+
+	/** Attempts to start a managed transaction. Returns the transaction index if successful, invalid index if not. */
+	int32 StartManagedTransaction(const FText& InTransactionDescription, UObject* InPrimaryObject = nullptr);
+
+	/** Cancels the managed transaction if this is the currently managed one. */
+	bool CancelManagedTransaction(int32 InTransactionId);
+
+	/** Ends the managed transaction if this is the currently managed one. */
+	bool EndManagedTransaction(int32 InTransactionId);
+
+	/** Cancels the unmanaged transaction if this is not the currently managed one. */
+	bool CancelUnmanagedTransaction(int32 InTransactionId);
+
+	/** Ends the unmanaged transaction if this is not the currently managed one. */
+	bool EndUnmanagedTransaction(int32 InTransactionId);
+
+protected:
+	int32 ManagedTransactionId;
+
+	FSimplePropertyTransactionManager();
+};
+
+/**
+ * Per-property transaction tracking. Kept out of the property templates so the transaction logic is compiled
+ * once rather than for every value type; the properties only supply the object to Modify().
+ *
+ * When a managed or unmanaged transaction is started with an undo owner, the first set inside the transaction
+ * records the old value as a per-property undo on that owner (see FSimplePropertyUndo), so there's no need to
+ * Modify() the owner or call FSimplePropertyUndo::Record by hand.
+ */
+class SIMPLEPROPERTIES_API FSimplePropertyTransactionState
+{
+public:
+	FSimplePropertyTransactionState() = default;
+
+	// Copies don't share the transaction.
+	FSimplePropertyTransactionState(const FSimplePropertyTransactionState& InOther)
+	{
+	}
+
+	// Moves take ownership of the transaction.
+	FSimplePropertyTransactionState(FSimplePropertyTransactionState&& InOther);
+
+	FSimplePropertyTransactionState& operator=(const FSimplePropertyTransactionState& InOther) = delete;
+	FSimplePropertyTransactionState& operator=(FSimplePropertyTransactionState&& InOther) = delete;
+
+	bool StartManagedTransaction(const FText& InTransactionDescription, UObject* InObject, UObject* InUndoOwner = nullptr);
+
+	UE_NODISCARD int32 StartUnmanagedTransaction(const FText& InTransactionDescription, UObject* InObject,
+		UObject* InUndoOwner = nullptr);
+
+	UE_NODISCARD TSharedPtr<FScopedTransaction> StartUnmanagedScopedTransaction(const FText& InTransactionDescription,
+		UObject* InObject);
+
+	ESimplePropertyTransactionEndResult CancelManagedTransaction();
+
+	ESimplePropertyTransactionEndResult EndManagedTransaction(bool bInCancelIfUnmodified);
+
+	ESimplePropertyTransactionEndResult CancelUnmanagedTransaction();
+
+	ESimplePropertyTransactionEndResult EndUnmanagedTransaction(bool bInCancelIfUnmodified);
+
+	bool HasManagedTransaction() const;
+
+	bool HasUnmanagedTransaction() const;
+
+	bool HasTransaction() const
+	{
+		return FSimplePropertyTransactionManager::IsValidTransactionId(TransactionId);
+	}
+
+	/** Returns true if we have a an active transaction and we've been modified. */
+	bool IsModified() const
+	{
+		return bModifiedInTransaction;
+	}
+
+	/** Called from the property's change path. */
+	void MarkModified()
+	{
+		if (HasTransaction())
+		{
+			bModifiedInTransaction = true;
+		}
+	}
+
+	/** Called before the property's value is replaced. True if the old value still needs recording. */
+	bool ShouldRecordUndo() const
+	{
+		return UndoOwner && !bUndoRecorded;
+	}
+
+	/** Records the property's current value as undo on the transaction's owner. */
+	void RecordUndo(void* InProperty, const FSimplePropertyUndoValueOps& InOps);
+
+protected:
+	int32 TransactionId = FSimplePropertyTransactionManager::GetInvalidTransactionId();
+
+	// The object the property is a member of, so it outlives the transaction. Only set while one is active.
+	UObject* UndoOwner = nullptr;
+
+	bool bModifiedInTransaction = false;
+	bool bUndoRecorded = false;
+
+	void Reset();
+};
+
+// The object a property's transactions Modify(). Only pointer values that convert to UObject* have one.
+template<typename InValueType>
+struct TSimplePropertyTransactionObject
+{
+	static UObject* GetTransactionObject(const InValueType& InValue)
+	{
+		if constexpr (std::is_pointer_v<InValueType> && std::is_convertible_v<InValueType, const UObject*>)
+		{
+			return FSimplePropertyTransactionManager::GetValidObject(InValue);
+		}
+
+		return nullptr;
+	}
+};
+
+template<typename InValueType>
+struct TSimplePropertyTransactionObject<TObjectPtr<InValueType>>
+{
+	static UObject* GetTransactionObject(const TObjectPtr<InValueType>& InValue)
+	{
+		return FSimplePropertyTransactionManager::GetValidObject(InValue.Get());
+	}
+};
+
+#endif
@@ -0,0 +1,260 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "Math/Color.h"
+#include "Math/Vector.h"
+#include "Math/Vector2D.h"
+#include "Math/Vector4.h"
+#include "SimpleProperty.h"
+
+enum class ESimplePropertyEase : uint8
+{
+	Linear,
+	EaseIn,
+	EaseOut,
+	EaseInOut
+};
+
+enum class ESimplePropertyTweenWrite : uint8
+{
+	// Set the property every frame the tween advances.
+	EveryFrame,
+	// Only set the property once, to the target, when the tween finishes.
+	OnFinish
+};
+
+/**
+ * How a value is split into the (up to 4) double lanes the tween manager interpolates. Specialize for your own
+ * types. Values are interpolated component-wise, so rotations and the like need their own handling.
+ */
+template<typename InValueType>
+struct TSimplePropertyTweenTraits;
+
+template<>
+struct TSimplePropertyTweenTraits<float>
+{
+	static void ToLanes(float InValue, double* OutLanes)
+	{
+		OutLanes[0] = InValue;
+	}
+
+	static float FromLanes(const double* InLanes)
+	{
+		return static_cast<float>(InLanes[0]);
+	}
+};
+
+template<>
+struct TSimplePropertyTweenTraits<double>
+{
+	static void ToLanes(double InValue, double* OutLanes)
+	{
+		OutLanes[0] = InValue;
+	}
+
+	static double FromLanes(const double* InLanes)
+	{
+		return InLanes[0];
+	}
+};
+
+template<>
+struct TSimplePropertyTweenTraits<FVector2D>
+{
+	static void ToLanes(const FVector2D& InValue, double* OutLanes)
+	{
+		OutLanes[0] = InValue.X;
+		OutLanes[1] = InValue.Y;
+	}
+
+	static FVector2D FromLanes(const double* InLanes)
+	{
+		return FVector2D(InLanes[0], InLanes[1]);
+	}
+};
+
+template<>
+struct TSimplePropertyTweenTraits<FVector>
+{
+	static void ToLanes(const FVector& InValue, double* OutLanes)
+	{
+		OutLanes[0] = InValue.X;
+		OutLanes[1] = InValue.Y;
+		OutLanes[2] = InValue.Z;
+	}
+
+	static FVector FromLanes(const double* InLanes)
+	{
+		return FVector(InLanes[0], InLanes[1], InLanes[2]);
+	}
+};
+
+template<>
+struct TSimplePropertyTweenTraits<FVector4>
+{
+	static void ToLanes(const FVector4& InValue, double* OutLanes)
+	{
+		OutLanes[0] = InValue.X;
+		OutLanes[1] = InValue.Y;
+		OutLanes[2] = InValue.Z;
+		OutLanes[3] = InValue.W;
+	}
+
+	static FVector4 FromLanes(const double* InLanes)
+	{
+		return FVector4(InLanes[0], InLanes[1], InLanes[2], InLanes[3]);
+	}
+};
+
+template<>
+struct TSimplePropertyTweenTraits<FLinearColor>
+{
+	static void ToLanes(const FLinearColor& InValue, double* OutLanes)
+	{
+		OutLanes[0] = InValue.R;
+		OutLanes[1] = InValue.G;
+		OutLanes[2] = InValue.B;
+		OutLanes[3] = InValue.A;
+	}
+
+	static FLinearColor FromLanes(const double* InLanes)
+	{
+		return FLinearColor(static_cast<float>(InLanes[0]), static_cast<float>(InLanes[1]),
+			static_cast<float>(InLanes[2]), static_cast<float>(InLanes[3]));
+	}
+};
+
+/**
+ * Identifies a running tween. A tween's slot in the manager's arrays changes as other tweens are retired, the handle
+ * doesn't, and it stops resolving once the tween has finished or been stopped.
+ */
+struct FSimplePropertyTweenHandle
+{
+	int32 Slot = INDEX_NONE;
+	uint32 Serial = 0;
+
+	bool IsValid() const
+	{
+		return Slot != INDEX_NONE;
+	}
+
+	bool operator==(const FSimplePropertyTweenHandle& InOther) const
+	{
+		return Slot == InOther.Slot && Serial == InOther.Serial;
+	}
+};
+
+/**
+ * Advances every active tween once per frame from the core ticker. Each tick makes three passes over flat arrays:
+ * the elapsed time and eased alpha of all tweens are computed 4 at a time, then every tween is interpolated with one
+ * vector multiply-add, then the results are set through each property's normal change path. Finished tweens are
+ * swapped out of the arrays, so after the arrays have grown, starting and retiring tweens doesn't allocate.
+ *
+ * Game thread only. Change callbacks may start or stop tweens.
+ */
+class SIMPLEPROPERTIES_API FSimplePropertyTweens
+{
+public:
+	static constexpr int32 MaxLanes = 4;
+
+	// InHandle is the tween being applied, or invalid when applied from Start or Stop by the property itself.
+	using FApplyFunction = void(*)(void* InProperty, const FSimplePropertyTweenHandle& InHandle, const double* InLanes);
+
+	/** Starts a tween, or retargets the running one if InOutHandle still resolves. */
+	static void Start(FSimplePropertyTweenHandle& InOutHandle, void* InProperty, FApplyFunction InApply, const double* InFrom,
+		const double* InTo, float InDuration, ESimplePropertyEase InEase, ESimplePropertyTweenWrite InWrite);
+
+	/** Stops the tween, optionally setting the property to the target first. Resets the handle. */
+	static void Stop(FSimplePropertyTweenHandle& InOutHandle, bool bInSnapToTarget = false);
+
+	/** Whether the tween is still running. */
+	static bool IsActive(const FSimplePropertyTweenHandle& InHandle);
+
+	static int32 GetNumActive();
+
+	/** Advances every tween. Called by the core ticker; call it directly to drive tweens manually. */
+	static void Tick(float InDeltaTime);
+
+	/** Called by the module. */
+	static void Initialize();
+	static void Shutdown();
+};
+
+/**
+ * A property that can be animated toward a target over time by FSimplePropertyTweens, instead of being set from a
+ * tick function on its owner. Setting it directly doesn't stop a running tween; call StopTween for that.
+ *
+ * The manager applies a tween through the property's address. It must not be moved in memory (e.g. by a TArray
+ * growing) while it's tweening, which is checked whenever the tween is applied or retargeted.
+ *
+ * Copies take the value but not the tween.
+ */
+template<typename InValueType, typename InPrivateType = UE::SimpleProperties::NoType>
+struct TSimpleTweenProperty : public TSimpleProperty<InValueType, InPrivateType>
+{
+	using Super = TSimpleProperty<InValueType, InPrivateType>;
+	using FValueType = typename Super::FValueType;
+	using FTweenTraits = TSimplePropertyTweenTraits<FValueType>;
+
+	using Super::Super;
+	using Super::operator=;
+
+	TSimpleTweenProperty() = default;
+
+	TSimpleTweenProperty(const TSimpleTweenProperty& InOther)
+		: Super(InOther)
+	{
+	}
+
+	TSimpleTweenProperty(TSimpleTweenProperty&& InOther)
+		: Super(MoveTemp(InOther))
+	{
+	}
+
+	~TSimpleTweenProperty()
+	{
+		StopTween();
+	}
+
+	bool operator=(const TSimpleTweenProperty& InOther)
+	{
+		return Super::SetInternal(InOther.Value);
+	}
+
+	void TweenTo(const FValueType& InTarget, float InDuration, ESimplePropertyEase InEase = ESimplePropertyEase::EaseInOut,
+		ESimplePropertyTweenWrite InWrite = ESimplePropertyTweenWrite::EveryFrame)
+	{
+		double From[FSimplePropertyTweens::MaxLanes] = {};
+		double To[FSimplePropertyTweens::MaxLanes] = {};
+		FTweenTraits::ToLanes(this->Value, From);
+		FTweenTraits::ToLanes(InTarget, To);
+
+		FSimplePropertyTweens::Start(TweenHandle, this, &Apply, From, To, InDuration, InEase, InWrite);
+	}
+
+	void StopTween(bool bInSnapToTarget = false)
+	{
+		if (TweenHandle.IsValid())
+		{
+			FSimplePropertyTweens::Stop(TweenHandle, bInSnapToTarget);
+		}
+	}
+
+	bool IsTweening() const
+	{
+		return FSimplePropertyTweens::IsActive(TweenHandle);
+	}
+
+protected:
+	FSimplePropertyTweenHandle TweenHandle;
+
+	static void Apply(void* InProperty, const FSimplePropertyTweenHandle& InHandle, const double* InLanes)
+	{
+		TSimpleTweenProperty& Property = *static_cast<TSimpleTweenProperty*>(InProperty);
+
+		checkf(!InHandle.IsValid() || Property.TweenHandle == InHandle, TEXT("A tween property was moved in memory while tweening."));
+
+		Property.SetInternal(FTweenTraits::FromLanes(InLanes));
+	}
+};
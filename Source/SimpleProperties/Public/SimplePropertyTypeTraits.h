@@ -3,14 +3,32 @@
 #pragma once
 
 #include "Concepts/EqualityComparable.h"
+#include "SimplePropertiesFwd.h"
 #include "SimplePropertyConcepts.h"
 #include "Templates/Models.h"
-#include "Templates/SharedPointer.h"
-#include "Templates/UnrealTypeTraits.h"
-#include "UObject/ObjectPtr.h"
+#include "Templates/SharedPointerFwd.h"
 
-class FReferenceCollector;
-class UObject;
+class UClass;
+
+template<typename T>
+struct TObjectPtr;
+
+template<typename T>
+struct TSoftObjectPtr;
+
+template<typename T>
+class TSoftClassPtr;
+
+// UObject-facing traits. Defined in SimplePropertyObjectTraits.h, apart from the transaction trait, which is in
+// SimplePropertyTransactionManager.h (editor only).
+template<typename InValueType>
+struct TSimplePropertyReferenceCollector;
+
+template<typename InValueType>
+struct TSimplePropertyInnerPropertyFinder;
+
+template<typename InValueType>
+struct TSimplePropertyTransactionObject;
 
 template<typename InValueType>
 struct TSimplePropertyValueTypes
@@ -62,75 +80,6 @@ struct TSimplePropertyComparator
 	}
 };
 
-template<typename InValueType>
-struct TSimplePropertyReferenceCollector
-{
-	enum
-	{
-		Struct = TModels<CCanCollectReferences, InValueType>::Value,
-		Object = TIsDerivedFrom<typename TRemovePointer<InValueType>::Type, UObject>::Value,
-		Value = Struct || Object
-	};
-
-	template<typename InValueType
-		UE_REQUIRES(Struct)>
-	static bool AddReferences(const InValueType& InValue, FReferenceCollector& InCollector)
-	{
-		return InValue->AddStructReferencedObjects(InCollector);
-	}
-
-	template<typename InValueType
-		UE_REQUIRES(Object)>
-	static bool AddReferences(const InValueType& InValue, FReferenceCollector& InCollector)
-	{
-		UObject* Value = InValue;
-
-		if (IsValid(Value))
-		{
-			PRAGMA_DISABLE_DEPRECATION_WARNINGS
-			InCollector.AddReferencedObject(Value);
-			PRAGMA_ENABLE_DEPRECATION_WARNINGS
-
-			return true;
-		}
-
-		return false;
-	}
-};
-
-template<typename InValueType>
-struct TSimplePropertyInnerPropertyFinder
-{
-	enum { Value = TModels<CCanFindInnerPropertyInstance, InValueType>::Value };
-
-	template<typename InValueType
-		UE_REQUIRES(Value)>
-	static bool FindInnerPropertyInstance(const InValueType& InValue, FName InPropertyName, const FProperty*& OutProp, const void*& OutData)
-	{
-		return InValue->FindInnerPropertyInstance(InPropertyName, OutProp, OutData);
-	}
-};
-
-template<typename InValueType>
-struct TSimplePropertyTransactionObject
-{
-	using IsPointerType = TIsPointer<InValueType>;
-	using IsUObjectPtr = TIsDerivedFrom<typename TRemovePointer<InValueType>::Type, UObject>;
-
-	static UObject* GetTransactionObject(const InValueType& InValue)
-	{
-		if constexpr(TAnd<IsPointerType, IsUObjectPtr>::Value)
-		{
-			if (IsValid(InValue))
-			{
-				return InValue;
-			}
-		}
-
-		return nullptr;
-	}
-};
-
 template<typename InValueType>
 struct TSimplePropertyTypeTraits
 {
@@ -142,28 +91,38 @@ struct TSimplePropertyTypeTraits
 };
 
 template<typename InValueType>
-struct TSimplePropertyReferenceCollector<TObjectPtr<InValueType>>
+struct TSimplePropertyValueTypes<TObjectPtr<InValueType>>
 {
 	using FValueType = TObjectPtr<InValueType>;
+	using FReferenceType = FValueType*;
+	using FPointerType = InValueType;
 
-	static bool AddReferences(const FValueType& InValue, FReferenceCollector& InCollector)
+	static const FReferenceType& GetReferenceValue(const FValueType& InValue)
 	{
-		if (IsValid(InValue.Get()))
-		{
-			FValueType ObjectPtr = InValue;
-			InCollector.AddReferencedObject(ObjectPtr);
-			return true;
-		}
+		return InValue;
+	}
 
-		return false;
+	static FReferenceType& GetReferenceValue(FValueType& InValue)
+	{
+		return InValue;
+	}
+
+	static const FPointerType* GetPointerValue(const FValueType& InValue)
+	{
+		return &InValue;
+	}
+
+	static FPointerType* GetPointerValue(FValueType& InValue)
+	{
+		return &InValue;
 	}
 };
 
 template<typename InValueType>
-struct TSimplePropertyValueTypes<TObjectPtr<InValueType>>
+struct TSimplePropertyValueTypes<TWeakPtr<InValueType>>
 {
-	using FValueType = TObjectPtr<InValueType>;
-	using FReferenceType = FValueType*;
+	using FValueType = TWeakPtr<InValueType>;
+	using FReferenceType = FValueType;
 	using FPointerType = InValueType;
 
 	static const FReferenceType& GetReferenceValue(const FValueType& InValue)
@@ -178,35 +137,47 @@ struct TSimplePropertyValueTypes<TObjectPtr<InValueType>>
 
 	static const FPointerType* GetPointerValue(const FValueType& InValue)
 	{
-		return &InValue;
+		return InValue.Pin().Get();
 	}
 
 	static FPointerType* GetPointerValue(FValueType& InValue)
 	{
-		return &InValue;
+		return InValue.Pin().Get();
 	}
 };
 
 template<typename InValueType>
-struct TSimplePropertyTransactionObject<TObjectPtr<InValueType>>
+struct TSimplePropertyValueTypes<TSharedPtr<InValueType>>
 {
-	using FValueType = TObjectPtr<InValueType>;
+	using FValueType = TSharedPtr<InValueType>;
+	using FReferenceType = FValueType;
+	using FPointerType = InValueType;
 
-	static UObject* GetTransactionObject(const FValueType& InValue)
+	static const FReferenceType& GetReferenceValue(const FValueType& InValue)
 	{
-		if (UObject* Object = InValue.Get(); IsValid(Object))
-		{
-			return Object;
-		}
+		return InValue;
+	}
 
-		return nullptr;
+	static FReferenceType& GetReferenceValue(FValueType& InValue)
+	{
+		return InValue;
+	}
+
+	static const FPointerType* GetPointerValue(const FValueType& InValue)
+	{
+		return InValue.Get();
+	}
+
+	static FPointerType* GetPointerValue(FValueType& InValue)
+	{
+		return InValue.Get();
 	}
 };
 
 template<typename InValueType>
-struct TSimplePropertyValueTypes<TWeakPtr<InValueType>>
+struct TSimplePropertyValueTypes<TSharedRef<InValueType>>
 {
-	using FValueType = TWeakPtr<InValueType>;
+	using FValueType = TSharedRef<InValueType>;
 	using FReferenceType = FValueType;
 	using FPointerType = InValueType;
 
@@ -222,19 +193,21 @@ struct TSimplePropertyValueTypes<TWeakPtr<InValueType>>
 
 	static const FPointerType* GetPointerValue(const FValueType& InValue)
 	{
-		return InValue.Pin().Get();
+		return &*InValue;
 	}
 
 	static FPointerType* GetPointerValue(FValueType& InValue)
 	{
-		return InValue.Pin().Get();
+		return &*InValue;
 	}
 };
 
+// Dereferencing a soft pointer only resolves it if it's already loaded, it never loads. Use TSimpleSoftProperty to
+// stream the asset in when the path is set.
 template<typename InValueType>
-struct TSimplePropertyValueTypes<TSharedPtr<InValueType>>
+struct TSimplePropertyValueTypes<TSoftObjectPtr<InValueType>>
 {
-	using FValueType = TSharedPtr<InValueType>;
+	using FValueType = TSoftObjectPtr<InValueType>;
 	using FReferenceType = FValueType;
 	using FPointerType = InValueType;
 
@@ -260,11 +233,11 @@ struct TSimplePropertyValueTypes<TSharedPtr<InValueType>>
 };
 
 template<typename InValueType>
-struct TSimplePropertyValueTypes<TSharedRef<InValueType>>
+struct TSimplePropertyValueTypes<TSoftClassPtr<InValueType>>
 {
-	using FValueType = TSharedRef<InValueType>;
+	using FValueType = TSoftClassPtr<InValueType>;
 	using FReferenceType = FValueType;
-	using FPointerType = InValueType;
+	using FPointerType = UClass;
 
 	static const FReferenceType& GetReferenceValue(const FValueType& InValue)
 	{
@@ -278,11 +251,11 @@ struct TSimplePropertyValueTypes<TSharedRef<InValueType>>
 
 	static const FPointerType* GetPointerValue(const FValueType& InValue)
 	{
-		return &*InValue;
+		return InValue.Get();
 	}
 
 	static FPointerType* GetPointerValue(FValueType& InValue)
 	{
-		return &*InValue;
+		return InValue.Get();
 	}
 };
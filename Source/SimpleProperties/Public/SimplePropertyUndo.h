@@ -0,0 +1,38 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#if WITH_EDITOR
+
+#include "SimplePropertyAccess.h"
+
+class UObject;
+
+/**
+ * Fine-grained undo for a single property. Instead of Modify()ing the whole owner, which serializes every field into
+ * the transaction, only the property's offset and current value are stored. Undo and redo swap just that value back
+ * and fire its change event.
+ *
+ * Properties record this themselves on their first set inside a transaction started with an undo owner
+ * (StartManagedTransaction(Description, Owner)). Call Record directly to cover other transactions, before changing
+ * the property. The owner must be transactional and the property must be a direct member of it (not in a separately
+ * allocated object).
+ */
+class SIMPLEPROPERTIES_API FSimplePropertyUndo
+{
+public:
+	template<typename InValueType, typename InPrivateType>
+	static bool Record(UObject* InOwner, TSimpleConstProperty<InValueType, InPrivateType>& InProperty)
+	{
+		return RecordValue(InOwner, &InProperty, FSimplePropertyAccess::GetUndoValueOps(InProperty));
+	}
+
+	/** Record without the property type. InOps must belong to the property's type. */
+	static bool RecordValue(UObject* InOwner, void* InProperty, const FSimplePropertyUndoValueOps& InOps);
+
+protected:
+	/** Offset of the property within the owner, or INDEX_NONE if there's no transaction or it isn't inside the owner. */
+	static int32 GetPropertyOffset(const UObject* InOwner, const void* InProperty);
+};
+
+#endif
@@ -19,10 +19,15 @@ public class SimpleProperties : ModuleRules
             new string[]
             {
                 "CoreUObject",
-                "Engine"
+                "Engine",
+                "NetCore"
             }
         );
 
+        // From the same target setting NetCore uses for WITH_PUSH_MODEL, so modules that include
+        // SimplePropertyPushModel.h agree with this one without depending on NetCore themselves.
+        PublicDefinitions.Add("SIMPLE_PROPERTIES_WITH_PUSH_MODEL=" + (Target.bWithPushModel ? "1" : "0"));
+
         if (Target.Type == TargetType.Editor)
         {
             PrivateDependencyModuleNames.Add("UnrealEd");
@@ -0,0 +1,87 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+#pragma once
+
+#include "FieldNotificationId.h"
+#include "INotifyFieldValueChanged.h"
+#include "SimplePropertyEvents.h"
+#include <type_traits>
+
+/**
+ * Whether anything is bound to a field of the owner, checked before the owner's virtual broadcast. Owners that keep a
+ * bit per bound field and expose it as GetEnabledFieldNotifications() are checked through it; specialize this for
+ * owners that track their bindings another way. Other owners are always broadcast.
+ */
+template<typename InOwnerType>
+struct TSimplePropertyFieldNotifyBinding
+{
+	static bool IsBound(const InOwnerType& InOwner, UE::FieldNotification::FFieldId InFieldId)
+	{
+		if constexpr (requires { InOwner.GetEnabledFieldNotifications(); })
+		{
+			const auto& EnabledFields = InOwner.GetEnabledFieldNotifications();
+			const int32 FieldIndex = InFieldId.GetIndex();
+
+			return EnabledFields.IsValidIndex(FieldIndex) && EnabledFields[FieldIndex];
+		}
+		else
+		{
+			return true;
+		}
+	}
+};
+
+/**
+ * Lets a property drive a field of a FieldNotify owner (e.g. an MVVM view model), so bound widgets update when the
+ * value actually changes instead of polling it every frame. The field is declared on the owner as usual - typically a
+ * FieldNotify getter:
+ *
+ *	UFUNCTION(BlueprintPure, FieldNotify)
+ *	float GetHealth() const { return *Health; }
+ *
+ *	TSimpleProperty<float> Health = {100.f, FSimplePropertyFieldNotify::Broadcast(this, FFieldNotificationClassDescriptor::GetHealth)};
+ *
+ * The broadcast only happens from the property's change path, which has already compared the values, and is skipped
+ * while nothing is bound to the field (see TSimplePropertyFieldNotifyBinding). Nothing is evaluated per frame.
+ *
+ * Lives in the SimplePropertiesFieldNotify module, so only modules that use it depend on FieldNotification.
+ *
+ * The owner must contain the property (or otherwise outlive it); it's captured as a raw pointer.
+ */
+struct FSimplePropertyFieldNotify
+{
+	using FFieldId = UE::FieldNotification::FFieldId;
+
+	template<typename InOwnerType>
+	static FSimplePropertyOnChange::FCallback Broadcast(InOwnerType* InOwner, FFieldId InFieldId)
+	{
+		static_assert(std::is_base_of_v<INotifyFieldValueChanged, InOwnerType>, "The owner must implement INotifyFieldValueChanged.");
+
+		return FSimplePropertyOnChange::FCallback::CreateLambda(
+			[InOwner, InFieldId]()
+			{
+				if (TSimplePropertyFieldNotifyBinding<InOwnerType>::IsBound(*InOwner, InFieldId))
+				{
+					InOwner->BroadcastFieldValueChanged(InFieldId);
+				}
+			});
+	}
+
+	/** Broadcasts the field and then calls InMethod on the owner, for properties that also have their own change handler. */
+	template<typename InOwnerType>
+	static FSimplePropertyOnChange::FCallback Broadcast(InOwnerType* InOwner, FFieldId InFieldId, void (InOwnerType::*InMethod)())
+	{
+		static_assert(std::is_base_of_v<INotifyFieldValueChanged, InOwnerType>, "The owner must implement INotifyFieldValueChanged.");
+
+		return FSimplePropertyOnChange::FCallback::CreateLambda(
+			[InOwner, InFieldId, InMethod]()
+			{
+				if (TSimplePropertyFieldNotifyBinding<InOwnerType>::IsBound(*InOwner, InFieldId))
+				{
+					InOwner->BroadcastFieldValueChanged(InFieldId);
+				}
+
+				(InOwner->*InMethod)();
+			});
+	}
+};
@@ -0,0 +1,21 @@
+// Copyright Matt Chapman. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class SimplePropertiesFieldNotify : ModuleRules
+{
+    public SimplePropertiesFieldNotify(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core",
+                "CoreUObject",
+                "FieldNotification",
+                "SimpleProperties"
+            }
+        );
+    }
+}